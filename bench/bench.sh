@@ -0,0 +1,63 @@
+#!/bin/sh
+# Benchmark του laxen σε συνθετικά κείμενα Zipf: κάθε συνδυασμός μεγέθους αρχείου, splitters (-l),
+# builders (-m) και topK (-t) εκτελείται REPEAT φορές και καταγράφεται σε μία γραμμή CSV με
+# πραγματικό χρόνο, CPU χρόνο (ρίζα και παιδιά), peak RSS και ρυθμό επεξεργασίας σε MB/s.
+#
+# Οι παράμετροι δίνονται με μεταβλητές περιβάλλοντος, π.χ.
+#     SIZES="16 64" SPLITTERS="1 4" BUILDERS="2" TOPK="10" LAXEN_ARGS="--threads" make bench
+#
+# Εκτελείται από τη ρίζα του repository (όπου βρίσκονται τα ./laxen, ./builder, ./splitter).
+
+SIZES=${SIZES:-"16 64"}                 # Μεγέθη κειμένου σε MB
+SPLITTERS=${SPLITTERS:-"1 2 4 8"}
+BUILDERS=${BUILDERS:-"1 2 4"}
+TOPK=${TOPK:-"10 100"}
+REPEAT=${REPEAT:-1}
+VOCABULARY=${VOCABULARY:-200000}        # Διαφορετικές λέξεις του κειμένου
+WORDS_PER_LINE=${WORDS_PER_LINE:-12}
+ZIPF=${ZIPF:-1.0}                       # Εκθέτης της κατανομής Zipf
+EXCLUDED=${EXCLUDED:-100}               # Οι πιο συχνές λέξεις μπαίνουν στην exclusion list
+SEED=${SEED:-1}
+LAXEN_ARGS=${LAXEN_ARGS:-}              # Επιπλέον ορίσματα του laxen για όλες τις εκτελέσεις
+DATA_DIR=${DATA_DIR:-bench/data}
+OUT=${BENCH_OUT:-bench/results.csv}
+
+mkdir -p "$DATA_DIR" || exit 1
+
+# Ένα κείμενο ανά μέγεθος. Ξαναφτιάχνεται μόνο αν αλλάξουν οι παράμετροι του generator.
+for size in $SIZES; do
+    corpus="$DATA_DIR/zipf-${size}M-v$VOCABULARY-w$WORDS_PER_LINE-z$ZIPF-r$SEED.txt"
+    if [ ! -f "$corpus" ]; then
+        echo "Generating $corpus"
+        ./bench/zipfgen -o "$corpus" -s "${size}M" -v "$VOCABULARY" -w "$WORDS_PER_LINE" -z "$ZIPF" -r "$SEED" \
+            -e "$DATA_DIR/exclusion-$EXCLUDED-v$VOCABULARY-r$SEED.txt" -x "$EXCLUDED" || exit 1
+    fi
+done
+
+echo "size_mb,splitters,builders,topk,args,run,real_s,cpu_s,peak_rss_kb,mb_per_s,exit_status" > "$OUT"
+for size in $SIZES; do
+    corpus="$DATA_DIR/zipf-${size}M-v$VOCABULARY-w$WORDS_PER_LINE-z$ZIPF-r$SEED.txt"
+    exclusion="$DATA_DIR/exclusion-$EXCLUDED-v$VOCABULARY-r$SEED.txt"
+    bytes=$(wc -c < "$corpus")
+    for l in $SPLITTERS; do
+        for m in $BUILDERS; do
+            for t in $TOPK; do
+                run=1
+                while [ "$run" -le "$REPEAT" ]; do
+                    # Τα ορίσματα του LAXEN_ARGS χωρίζονται σκόπιμα σε λέξεις
+                    result=$(./bench/measure ./laxen -i "$corpus" -l "$l" -m "$m" -t "$t" -e "$exclusion" \
+                             -o "$DATA_DIR/out.txt" $LAXEN_ARGS) || exit 1
+                    real=${result%%,*}
+                    rate=$(awk -v b="$bytes" -v s="$real" 'BEGIN { printf "%.2f", (s > 0 ? b / 1048576 / s : 0) }')
+                    line="$size,$l,$m,$t,\"$LAXEN_ARGS\",$run,$result"
+                    # Ο ρυθμός μπαίνει πριν από το exit status
+                    echo "${line%,*},$rate,${line##*,}" >> "$OUT"
+                    echo "size=${size}M l=$l m=$m t=$t run=$run: ${real}s, $rate MB/s"
+                    run=$((run + 1))
+                done
+            done
+        done
+    done
+done
+rm -f fifo_* "$DATA_DIR/out.txt"
+echo "Results written to $OUT"
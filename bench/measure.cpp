@@ -0,0 +1,56 @@
+// measure.cpp
+// Εκτέλεση μιας εντολής και μέτρηση του πραγματικού χρόνου, του CPU χρόνου και της μέγιστης
+// μνήμης (peak RSS). Τα στοιχεία της wait4() περιλαμβάνουν και τις διεργασίες-παιδιά της εντολής
+// (splitters, builders) που έχουν τερματίσει. Τυπώνει στο stdout μία γραμμή
+//     real_seconds,cpu_seconds,peak_rss_kb,exit_status
+// ενώ η έξοδος της εντολής στέλνεται στο /dev/null.
+#include <iostream>
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+static double clockSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: ./measure command [args...]" << std::endl;
+        return 1;
+    }
+
+    double t1 = clockSeconds();
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return 1;
+    } else if (pid == 0) {  // Διαδικασία παιδιού
+        int devNull = open("/dev/null", O_WRONLY);
+        if (devNull != -1) {
+            dup2(devNull, STDOUT_FILENO);
+            close(devNull);
+        }
+        execvp(argv[1], argv + 1);
+        std::perror("execvp");
+        _exit(127);
+    }
+
+    int status;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) == -1) {
+        std::perror("wait4");
+        return 1;
+    }
+    double t2 = clockSeconds();
+
+    double cpu = static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                 static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    int exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    std::printf("%.3f,%.3f,%ld,%d\n", t2 - t1, cpu, usage.ru_maxrss, exitStatus);
+    return 0;
+}
@@ -0,0 +1,196 @@
+// zipfgen.cpp
+// Ντετερμινιστική παραγωγή συνθετικού κειμένου για τα benchmarks: οι λέξεις ακολουθούν κατανομή
+// Zipf (η λέξη με κατάταξη r εμφανίζεται με πιθανότητα ανάλογη του 1 / r^s) και οι ίδιες
+// παράμετροι δίνουν πάντα το ίδιο αρχείο.
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include "../vector.hpp"
+
+// Δομή Παραμέτρων
+struct Parameters {
+    char outputFile[256];
+    char exclusionFile[256];    // Αρχείο με τις πιο συχνές λέξεις ως exclusion list (κενό = χωρίς)
+    long long size;             // Μέγεθος του κειμένου σε bytes
+    int vocabulary;             // Πλήθος διαφορετικών λέξεων
+    int wordsPerLine;           // Μέσο πλήθος λέξεων ανά γραμμή
+    double exponent;            // Εκθέτης s της κατανομής Zipf
+    int excluded;               // Πλήθος λέξεων της exclusion list
+    unsigned long long seed;
+};
+
+// Γεννήτρια ψευδοτυχαίων αριθμών splitmix64
+class Random {
+private:
+    uint64_t state;
+
+public:
+    explicit Random(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Ομοιόμορφα στο [0, 1)
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// Συνάρτηση για ανάλυση των ορισμάτων
+Parameters parseArguments(int argc, char* argv[]);
+
+// Μέγεθος με προαιρετικό πολλαπλασιαστή K, M ή G (π.χ. 64M)
+long long parseSize(const char* text);
+
+// Η λέξη με κατάταξη rank: ο δείκτης της σε βάση 26, ώστε να είναι μοναδική, και τυχαίο μήκος
+void makeWord(int rank, uint64_t seed, char* word);
+
+int main(int argc, char* argv[]) {
+    Parameters params = parseArguments(argc, argv);
+
+    // Λεξιλόγιο και αθροιστική κατανομή των κατατάξεων
+    Vector<char*> words;
+    words.reserve(params.vocabulary);
+    Vector<double> cdf;
+    cdf.reserve(params.vocabulary);
+    double total = 0;
+    for (int r = 0; r < params.vocabulary; r++) {
+        char* word = new char[16];
+        makeWord(r, params.seed, word);
+        words.push_back(word);
+        total += 1.0 / std::pow(r + 1, params.exponent);
+        cdf.push_back(total);
+    }
+
+    FILE* out = std::fopen(params.outputFile, "w");
+    if (out == NULL) {
+        std::perror("fopen output file");
+        return 1;
+    }
+    static char outBuffer[1 << 20];
+    std::setvbuf(out, outBuffer, _IOFBF, sizeof(outBuffer));
+
+    // Γραμμές μέχρι να φτάσει το μέγεθος, ώστε το αρχείο να τελειώνει σε πλήρη γραμμή
+    Random random(params.seed);
+    long long written = 0;
+    while (written < params.size) {
+        int count = 1 + static_cast<int>(random.next() % (2 * params.wordsPerLine - 1));
+        for (int i = 0; i < count; i++) {
+            // Δυαδική αναζήτηση της κατάταξης στην αθροιστική κατανομή
+            double u = random.uniform() * total;
+            int low = 0, high = params.vocabulary - 1;
+            while (low < high) {
+                int mid = low + (high - low) / 2;
+                if (cdf[mid] < u) low = mid + 1; else high = mid;
+            }
+            if (i > 0) {
+                std::fputc(' ', out);
+                written++;
+            }
+            std::fputs(words[low], out);
+            written += static_cast<long long>(std::strlen(words[low]));
+        }
+        std::fputc('\n', out);
+        written++;
+    }
+    if (std::fclose(out) != 0) {
+        std::perror("write output file");
+        return 1;
+    }
+
+    // Οι πιο συχνές λέξεις ως exclusion list, όπως οι stopwords ενός πραγματικού κειμένου
+    if (strlen(params.exclusionFile) > 0) {
+        FILE* excl = std::fopen(params.exclusionFile, "w");
+        if (excl == NULL) {
+            std::perror("fopen exclusion file");
+            return 1;
+        }
+        for (int r = 0; r < params.excluded && r < params.vocabulary; r++) std::fprintf(excl, "%s\n", words[r]);
+        if (std::fclose(excl) != 0) {
+            std::perror("write exclusion file");
+            return 1;
+        }
+    }
+
+    for (size_t i = 0; i < words.get_size(); i++) delete[] words[i];
+    return 0;
+}
+
+Parameters parseArguments(int argc, char* argv[]) {
+    Parameters params = {"", "", 0, 100000, 12, 1.0, 0, 1};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            strncpy(params.outputFile, argv[i + 1], 255);
+            params.outputFile[255] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            strncpy(params.exclusionFile, argv[i + 1], 255);
+            params.exclusionFile[255] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            params.size = parseSize(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) {
+            params.vocabulary = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            params.wordsPerLine = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-z") == 0 && i + 1 < argc) {
+            params.exponent = std::strtod(argv[i + 1], NULL);
+            i++;
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            params.excluded = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            params.seed = std::strtoull(argv[i + 1], NULL, 10);
+            i++;
+        }
+    }
+
+    if (strlen(params.outputFile) == 0 || params.size <= 0 || params.vocabulary <= 0 || params.wordsPerLine <= 0 ||
+        params.exponent < 0 || params.excluded < 0) {
+        std::cerr << "Usage: ./zipfgen -o outputfile -s size[K|M|G] [-v vocabulary] [-w wordsPerLine] [-z exponent]"
+                  << " [-r seed] [-e exclusionfile -x numOfExcluded]" << std::endl;
+        std::exit(1);
+    }
+
+    return params;
+}
+
+long long parseSize(const char* text) {
+    char* end;
+    long long size = std::strtoll(text, &end, 10);
+    switch (*end) {
+        case 'K': case 'k': return size << 10;
+        case 'M': case 'm': return size << 20;
+        case 'G': case 'g': return size << 30;
+        case '\0': return size;
+        default: return -1;
+    }
+}
+
+void makeWord(int rank, uint64_t seed, char* word) {
+    // Πλήθος ψηφίων του δείκτη σε βάση 26 (το πολύ 7 για rank < 26^7)
+    int digits = 1;
+    for (int n = rank / 26; n > 0; n /= 26) digits++;
+
+    // Το πρώτο γράμμα δηλώνει το πλήθος των ψηφίων, ώστε το τυχαίο τμήμα να μη δημιουργεί συγκρούσεις
+    int length = 0;
+    word[length++] = static_cast<char>('a' + digits);
+    int n = rank;
+    for (int i = 0; i < digits; i++) {
+        word[length++] = static_cast<char>('a' + n % 26);
+        n /= 26;
+    }
+    Random random(seed ^ (static_cast<uint64_t>(rank) * 0xD1B54A32D192ED03ULL));
+    int tail = static_cast<int>(random.next() % 6);
+    for (int i = 0; i < tail; i++) word[length++] = static_cast<char>('a' + random.next() % 26);
+    word[length] = '\0';
+}
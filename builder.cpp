@@ -4,8 +4,18 @@
 #include <unistd.h>
 #include <cstdlib>
 #include <cstring>
-#include <sys/times.h> 
+#include <sys/resource.h>
+#include <sys/epoll.h>
+#include <cerrno>
+#include <climits>
 #include "vector.hpp"
+#include "wordmap.hpp"
+#include "wire.hpp"
+#include "writebuffer.hpp"
+#include "buildercore.hpp"
+#include "ring.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
 
 // Δομή Παραμέτρων
 struct Parameters {
@@ -13,12 +23,54 @@ struct Parameters {
     int builderID;
     int numOfSplitters;
     int topK;
+    int ringFd;         // fd του πλέγματος δακτυλίων κοινής μνήμης από τη ρίζα (-1 = named pipes)
+    bool follow;        // Αποστολή των topK στη ρίζα στο τέλος κάθε εποχής (--follow)
+    double approxEpsilon;   // Προσεγγιστική καταμέτρηση με σφάλμα <= epsilon * N (--approx, 0 = ακριβής)
+    long long memBudget;    // Όριο μνήμης των counts σε bytes πριν την εγγραφή τους σε run (--mem-budget, 0 = χωρίς όριο)
+    char traceFile[256];    // Αρχείο trace της ρίζας για τις φάσεις του builder (--trace, κενό = χωρίς)
 };
 
-// Δομή που χρησιμοποιείται για την αποθήκευση μιας λέξης και του πλήθους εμφάνισής της
-struct WordCount {
-    char word[64];
-    int count;
+// Αποστολή των topK λέξεων των counts στη ρίζα μέσω του named pipe fifo_builder%d_laxen σε δυαδική μορφή.
+// Με --follow στέλνεται ένα στιγμιότυπο στο τέλος κάθε εποχής, ακολουθούμενο από τη σήμανσή της.
+// Με --approx κάθε λέξη συνοδεύεται από το μέγιστο σφάλμα του count της. Τα counts δεν είναι const,
+// αφού με --mem-budget η επιλογή των topK συγχωνεύει τα runs.
+template <typename Counts>
+class ResultWriter : public EpochListener {
+private:
+    WriteBuffer output;
+    WireWriter writer;
+    Counts& counts;
+    size_t topK;
+
+public:
+    ResultWriter(int fd, Counts& counts, size_t topK, unsigned flags)
+        : output(fd, 64 * 1024), writer(output, flags), counts(counts), topK(topK) {}
+
+    bool begin() { return writer.begin(); }
+
+    // Εγγραφή των topK λέξεων σε φθίνουσα σειρά ως προς το count
+    bool writeTopK() {
+        Vector<RankedWord> wordVector;
+        {
+            TraceSpan span("select topK");
+            wordVector = selectTopK(counts, topK);
+        }
+        TraceSpan span("send results");
+        for (size_t i = 0; i < wordVector.get_size(); i++) {
+            if (!writer.word(wordVector[i].word, wordVector[i].length, 0, wordVector[i].count, wordVector[i].error)) return false;
+        }
+        return true;
+    }
+
+    bool epochComplete(uint64_t epoch) { return writeTopK() && writer.mark(epoch) && output.flush(); }
+
+    // Αποστολή και κλείσιμο του output FIFO
+    bool close() {
+        TraceSpan span("send results");
+        return output.close();
+    }
+
+    size_t get_writeCalls() const { return output.get_writeCalls(); }
 };
 
 // Συνάρτηση για ανάλυση των ορισμάτων
@@ -26,133 +78,69 @@ Parameters parseArguments(int argc, char* argv[]);
 
 // Συνάρτηση που μετατρέπει έναν ακέραιο σε συμβολοσειρά
 const char* intToStr(int number);
- 
-// Ελέγχει αν η λέξη υπάρχει ήδη στον vec.
-// Αν υπάρχει, αυξάνει το count της αντίστοιχης λέξης.
-// Αν δεν υπάρχει, δημιουργεί ένα νέο WordCount αντικείμενο, το προσθέτει στον vec και θέτει το count σε 1.
-void processWord(char buffer[64], Vector<WordCount>& vec);
 
-// Πρότυπη συνάρτηση για την ταξινόμηση ενός Vector σε σχεση με το count
-template <typename T, typename Compare>
-void vector_sort(Vector<T>& vec, Compare comp);
+// Καταμέτρηση των named pipes των splitters μέχρι να κλείσουν όλα. Τα pipes παρακολουθούνται
+// με epoll και διαβάζονται χωρίς μπλοκάρισμα. Ο listener (προαιρετικός) ειδοποιείται για κάθε εποχή.
+// Οι αναγνώσεις και ο χρόνος αναμονής στο epoll_wait προστίθενται στο stats.
+template <typename Counts>
+bool countFromFifos(const Parameters& params, Counts& counts, EpochListener* listener, ProcessStats& stats);
 
+// Καταμέτρηση όλων των ροών στα counts και αποστολή των αποτελεσμάτων στη ρίζα (false σε σφάλμα)
+template <typename Counts>
+bool countAndReport(const Parameters& params, Counts& counts, unsigned resultFlags, ProcessStats& stats);
 
-int main(int argc, char* argv[]) {
-    struct tms tb1, tb2;
+// Άνοιγμα του named pipe προς τη ρίζα για εγγραφή (-1 σε αποτυχία)
+int openResultFifo(int builderID);
 
-    // Αριθμός ticks ανά δευτερόλεπτο
-    double ticspersec = static_cast<double>(sysconf(_SC_CLK_TCK));
 
+int main(int argc, char* argv[]) {
     // Μέτρηση αρχικού χρόνου
-    double t1 = static_cast<double>(times(&tb1));
+    double t1 = clockSeconds(CLOCK_MONOTONIC);
+    double c1 = clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+    ProcessStats stats;
 
     // Ανάλυση ορισμάτων
     Parameters params = parseArguments(argc, argv);
 
-    Vector<int> splitterPipeDescriptors;
-    for (int i = 0; i < params.numOfSplitters; i++) { 
-        // Δημιουργία ονόματος για το named pipe
-        char fifo_path[50];
-        sprintf(fifo_path, "fifo_splitter%d_builder%d", i, params.builderID);
-
-        // Άνοιγμα του named pipe για ανάγνωση σε blocking mode
-        int fd = open(fifo_path, O_RDONLY);
-        if (fd == -1) {
-            std::perror("open");
-            std::exit(EXIT_FAILURE);
-        }
-        splitterPipeDescriptors.push_back(fd);      // Αποθήκευση του file descriptor στον vector
-    }
-
-    // Δομή για αποθήκευση λέξεων και μετρήσεων
-    Vector<WordCount> wordVector;
-
-    const size_t buffer_size = 1024;
-    char buffer[buffer_size];
-
-    // Δείκτες για ενεργά FIFOs
-    Vector<bool> activeFds;
-    for (int i = 0; i < params.numOfSplitters; i++) activeFds.push_back(true);
-    
-    int activeCount = params.numOfSplitters;    // Αριθμός ενεργών FIFOs
-
-    // Βρόχος ανάγνωσης δεδομένων μέχρι να κλείσουν όλα τα FIFOs
-    while (activeCount > 0) {
-        for (int i = 0; i < params.numOfSplitters; i++) { 
-            if (activeFds[i]) {     // Ελέγχει αν το FIFO είναι ακόμα ενεργό
-                ssize_t bytes_read = read(splitterPipeDescriptors[i], buffer, buffer_size - 1);
-                
-                if (bytes_read == -1) {     // Έλεγχος σφαλμάτων ανάγνωσης
-                    std::perror("read");
-                    return 2;
-                }
-                if (bytes_read == 0) {      // Ανάγνωση EOF, το FIFO είναι πλέον κλειστό
-                    activeFds[i] = false;
-                    activeCount--;
-                    break; 
-                }
-
-                buffer[bytes_read] = '\0';  // Διασφάλιση null-τερματισμού για ασφαλή επεξεργασία ως string
-
-                // Διαχωρισμός λέξεων από τον buffer
-                char* token = strtok(buffer, " \n");
-                while (token != NULL) {
-                    processWord(token, wordVector);  // Καταμέτρηση λέξης στον wordVector
-                    token = strtok(NULL, " \n");     // Επόμενο token
-                }
-            }
-        }
+    // Καταγραφή των φάσεων, που προστίθενται στο αρχείο trace στο τέλος
+    TraceBuffer* trace = nullptr;
+    if (params.traceFile[0] != '\0') {
+        char label[32];
+        snprintf(label, sizeof(label), "builder %d", params.builderID);
+        trace = new TraceBuffer(label, true);
+        trace->activate();
     }
 
-    // Ταξινόμηση του wordVector με βάση το count των λέξεων σε φθίνουσα σειρά
-    vector_sort(wordVector, [](const WordCount& a, const WordCount& b) {
-        return a.count > b.count;
-    });
-
-    // Δημιουργία διαδρομής για το named pipe που θα συνδέει τον builder με το laxen
-    char fifo_path[50];
-    sprintf(fifo_path, "fifo_builder%d_laxen", params.builderID);
-    // Άνοιγμα του named pipe για εγγραφή
-    int outputFifoFd = open(fifo_path, O_WRONLY);
-    if (outputFifoFd == -1) {
-        std::perror("open");
-        return EXIT_FAILURE;
+    // Πίνακας κατακερματισμού για ακριβή καταμέτρηση ή, με --approx, Space-Saving σε σταθερή μνήμη.
+    // Με --mem-budget τα counts γράφονται σε runs στο δίσκο όταν ξεπεράσουν το όριο.
+    bool ok;
+    if (params.approxEpsilon > 0) {
+        SpaceSaving sketch(SpaceSaving::capacityFor(params.approxEpsilon, params.topK));
+        ok = countAndReport(params, sketch, WIRE_ERRORS, stats);
+    } else if (params.memBudget > 0) {
+        SpillingCounts counts(static_cast<size_t>(params.memBudget), params.follow);
+        ok = countAndReport(params, counts, 0, stats) && counts.ok();
+    } else {
+        WordMap wordMap;
+        ok = countAndReport(params, wordMap, 0, stats);
     }
+    if (!ok) return 2;
 
-    // Εγγραφή των topK λέξεων στο named pipe
-    for (size_t i = 0; i < static_cast<size_t>(params.topK) && i < wordVector.get_size(); i++) {
-        char write_path[70];
-        snprintf(write_path, sizeof(write_path), "%s-%d", wordVector[i].word, wordVector[i].count);   // Δημιουργία εγγραφής "λέξη-αριθμός"  
-
-        if (strlen(write_path) < 3) break;  // Έλεγχος για μη έγκυρες εγγραφές
+    // Μέτρηση τελικού χρόνου και CPU χρόνου
+    stats.realTime = clockSeconds(CLOCK_MONOTONIC) - t1;
+    stats.cpuTime = clockSeconds(CLOCK_PROCESS_CPUTIME_ID) - c1;
+    collectUsage(stats, RUSAGE_SELF);
 
-        ssize_t bytes_written = write(outputFifoFd, write_path, strlen(write_path));     // Εγγραφή στο FIFO
-        if (bytes_written == -1) {   // Έλεγχος σφαλμάτων κατά την εγγραφή
-            std::perror("write");
-            close(outputFifoFd);
-            for (size_t i = 0; i < splitterPipeDescriptors.get_size(); i++) close(splitterPipeDescriptors[i]);     // Κλείσιμο όλων των splitter pipes
-            return EXIT_FAILURE;
-        }
-
-        // Γράψιμο χαρακτήρα νέας γραμμής για διαχωρισμό εγγραφών
-        write(outputFifoFd, "\n", 1);
+    if (trace != nullptr) {
+        currentTrace = nullptr;
+        appendTraceFile(params.traceFile, *trace);
+        delete trace;
     }
-    // Κλείσιμο του output FIFO μετά την ολοκλήρωση
-    close(outputFifoFd);
-
-    // Κλείσιμο όλων των pipes προς τους splitters
-    for (size_t i = 0; i < splitterPipeDescriptors.get_size(); i++) close(splitterPipeDescriptors[i]);
-
-    // Μέτρηση τελικού χρόνου
-    double t2 = static_cast<double>(times(&tb2));
 
-    // Υπολογισμός CPU χρόνου
-    double cpu_time = static_cast<double>((tb2.tms_utime + tb2.tms_stime) - (tb1.tms_utime + tb1.tms_stime));
-
-    // Ειδοποίηση της ρίζας ότι ο builder ολοκλήρωσε την εργασία του
-    char write_path[70];
-    snprintf(write_path, sizeof(write_path), "BuilderDonee-%d-%f-%f", params.builderID, (t2 - t1) / ticspersec, cpu_time / ticspersec); 
-    if (write(params.pipe_write_fd, write_path, std::strlen(write_path) + 1) < 0) {
+    // Ειδοποίηση της ρίζας ότι ο builder ολοκλήρωσε την εργασία του, με τους μετρητές του
+    char write_path[PIPE_BUF];
+    size_t messageLength = formatDoneMessage(write_path, sizeof(write_path), "BuilderDonee", params.builderID, stats);
+    if (write(params.pipe_write_fd, write_path, messageLength + 1) < 0) {
         std::cerr << "Error writing BuilderDone message to pipe." << std::endl;
     }
     close(params.pipe_write_fd); // Κλείσιμο του pipe επικοινωνίας
@@ -162,7 +150,7 @@ int main(int argc, char* argv[]) {
 
 
 Parameters parseArguments(int argc, char* argv[]) {
-    Parameters params = {-1, -1, 0, 0};
+    Parameters params = {-1, -1, 0, 0, -1, false, 0, 0, ""};
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
@@ -174,14 +162,30 @@ Parameters parseArguments(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) { 
             params.topK = std::atoi(argv[i + 1]);
             i++;
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            params.approxEpsilon = std::strtod(argv[i + 1], NULL);
+            i++;
+        } else if (strcmp(argv[i], "-B") == 0 && i + 1 < argc) {
+            params.memBudget = std::strtoll(argv[i + 1], NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "-tr") == 0 && i + 1 < argc) {
+            strncpy(params.traceFile, argv[i + 1], 255);
+            params.traceFile[255] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "-F") == 0) {
+            params.follow = true;
+        } else if (strcmp(argv[i], "-R") == 0 && i + 1 < argc) {
+            params.ringFd = std::atoi(argv[i + 1]);
+            i++;
         } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) { 
             params.numOfSplitters = std::atoi(argv[i + 1]);
             i++;
         }
     }
 
-    if (params.pipe_write_fd < 0 || params.builderID < 0 || params.topK <= 0  || params.numOfSplitters <= 0) {
-        std::cerr << "Usage: ./builder -p pipe_write_fd -id builderID -t topK -l numOfSplitters" << std::endl;
+    if (params.pipe_write_fd < 0 || params.builderID < 0 || params.topK <= 0  || params.numOfSplitters <= 0 ||
+        params.approxEpsilon < 0 || params.approxEpsilon >= 1 || params.memBudget < 0) {
+        std::cerr << "Usage: ./builder -p pipe_write_fd -id builderID -t topK -l numOfSplitters [-R ringMeshFd] [-F] [-a epsilon] [-B memBudgetBytes] [-tr traceFile]" << std::endl;
         std::exit(1);
     }
 
@@ -199,36 +203,166 @@ const char* intToStr(int number) {
     return str;
 }
 
-void processWord(char buffer[64], Vector<WordCount>& vec) {
-    // Αναζήτηση της λέξης στον vector
-    for (size_t i = 0; i < vec.get_size(); ++i) {
-        if (strcmp(vec[i].word, buffer) == 0) {
-            // Αν η λέξη βρέθηκε, αύξησε τον μετρητή
-            vec[i].count++;
-            return;
+template <typename Counts>
+bool countAndReport(const Parameters& params, Counts& counts, unsigned resultFlags, ProcessStats& stats) {
+    // Με --follow τα στιγμιότυπα στέλνονται κατά τη μέτρηση, οπότε το output ανοίγει από την αρχή
+    ResultWriter<Counts>* results = nullptr;
+    if (params.follow) {
+        int outputFifoFd = openResultFifo(params.builderID);
+        if (outputFifoFd == -1) return false;
+        results = new ResultWriter<Counts>(outputFifoFd, counts, params.topK, resultFlags);
+        if (!results->begin()) return false;
+    }
+
+    // Καταμέτρηση από τους δακτυλίους κοινής μνήμης ή από τα named pipes των splitters
+    if (params.ringFd >= 0) {
+        RingMesh mesh;
+        bool attached = mesh.attach(params.ringFd);
+        close(params.ringFd);
+        if (!attached || mesh.numOfSplitters() != params.numOfSplitters || params.builderID >= mesh.numOfBuilders()) {
+            std::cerr << "Builder " << params.builderID << ": unusable ring mesh" << std::endl;
+            return false;
         }
+        Vector<SpscRing*> rings;
+        for (int i = 0; i < params.numOfSplitters; i++) {
+            rings.push_back(new SpscRing(mesh.ring(i, params.builderID), mesh.doorbell(params.builderID)));
+        }
+        bool counted = countFromRings(rings, *mesh.doorbell(params.builderID), counts, results, stats);
+        for (size_t i = 0; i < rings.get_size(); i++) delete rings[i];
+        if (!counted) return false;
+    } else if (!countFromFifos(params, counts, results, stats)) {
+        return false;
+    }
+    stats.distinctWords = static_cast<long long>(counts.get_size());
+    stats.tableBytes = static_cast<long long>(counts.memoryUsage());
+
+    // Τελικά αποτελέσματα: οι topK λέξεις μετά το κλείσιμο όλων των ροών
+    bool ok = true;
+    if (results == nullptr) {
+        int outputFifoFd = openResultFifo(params.builderID);
+        if (outputFifoFd == -1) return false;
+        results = new ResultWriter<Counts>(outputFifoFd, counts, params.topK, resultFlags);
+        ok = results->begin();
     }
+    if (ok) ok = results->writeTopK();
+    if (!results->close()) ok = false;
+    stats.writeCalls += static_cast<long long>(results->get_writeCalls());
+    delete results;
+    return ok;
+}
 
-    // Αν η λέξη δεν βρέθηκε, πρόσθεσέ την με αρχική τιμή count = 1
-    WordCount newWord;
-    strcpy(newWord.word, buffer);
-    newWord.count = 1;
-    vec.push_back(newWord);
+int openResultFifo(int builderID) {
+    // Δημιουργία διαδρομής για το named pipe που θα συνδέει τον builder με το laxen
+    char fifo_path[50];
+    sprintf(fifo_path, "fifo_builder%d_laxen", builderID);
+    // Άνοιγμα του named pipe για εγγραφή
+    int fd = open(fifo_path, O_WRONLY);
+    if (fd == -1) std::perror("open");
+    return fd;
 }
 
-template <typename T, typename Compare>
-void vector_sort(Vector<T>& vec, Compare comp) {
-    size_t n = vec.get_size();
-    // Εφαρμογή αλγορίθμου ταξινόμησης
-    for (size_t i = 0; i < n - 1; ++i) {
-        for (size_t j = 0; j < n - i - 1; ++j) {
-            // Χρήση της συνάρτησης σύγκρισης comp για να αποφασιστεί η σειρά
-            if (comp(vec[j + 1], vec[j])) {
-                // Ανταλλαγή των στοιχείων vec[j] και vec[j + 1]
-                T temp = vec[j];
-                vec[j] = vec[j + 1];
-                vec[j + 1] = temp;
+template <typename Counts>
+bool countFromFifos(const Parameters& params, Counts& counts, EpochListener* listener, ProcessStats& stats) {
+    Vector<int> splitterPipeDescriptors;
+    for (int i = 0; i < params.numOfSplitters; i++) { 
+        // Δημιουργία ονόματος για το named pipe
+        char fifo_path[50];
+        sprintf(fifo_path, "fifo_splitter%d_builder%d", i, params.builderID);
+
+        // Άνοιγμα του named pipe για ανάγνωση σε blocking mode (περιμένει μέχρι να το ανοίξει ο splitter)
+        TraceSpan span("open fifo");
+        int fd = open(fifo_path, O_RDONLY);
+        if (fd == -1) {
+            std::perror("open");
+            return false;
+        }
+        splitterPipeDescriptors.push_back(fd);      // Αποθήκευση του file descriptor στον vector
+    }
+
+    // Ένας αποκωδικοποιητής ανά FIFO, αφού οι εγγραφές μπορεί να κοπούν στο όριο δύο αναγνώσεων
+    WireReader* readers = new WireReader[params.numOfSplitters];
+    EpochTracker epochs(params.numOfSplitters, listener);
+
+    // Τα FIFOs παρακολουθούνται με epoll και διαβάζονται χωρίς μπλοκάρισμα. Ένα blocking read σε άδειο
+    // FIFO θα καθυστερούσε τον builder στον πιο αργό splitter, ενώ οι υπόλοιποι θα περίμεναν να αδειάσουν
+    // τα γεμάτα FIFOs τους.
+    int epollFd = epoll_create1(0);
+    if (epollFd == -1) {
+        std::perror("epoll_create1");
+        return false;
+    }
+    for (int i = 0; i < params.numOfSplitters; i++) {
+        int fd = splitterPipeDescriptors[i];
+        if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == -1) {
+            std::perror("fcntl");
+            return false;
+        }
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.u32 = static_cast<uint32_t>(i);     // Ο αριθμός του splitter
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+            std::perror("epoll_ctl");
+            return false;
+        }
+    }
+
+    int activeCount = params.numOfSplitters;    // Αριθμός ενεργών FIFOs
+    struct epoll_event* events = new struct epoll_event[params.numOfSplitters];
+
+    // Βρόχος ανάγνωσης δεδομένων μέχρι να κλείσουν όλα τα FIFOs
+    while (activeCount > 0) {
+        // Αναμονή μέχρι κάποιο ενεργό FIFO να έχει δεδομένα ή να κλείσει
+        int ready;
+        {
+            TraceSpan span("wait");
+            double start = clockSeconds(CLOCK_MONOTONIC);
+            ready = epoll_wait(epollFd, events, params.numOfSplitters, -1);
+            stats.readBlocked += clockSeconds(CLOCK_MONOTONIC) - start;
+        }
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            std::perror("epoll_wait");
+            return false;
+        }
+
+        for (int e = 0; e < ready; e++) {
+            int i = static_cast<int>(events[e].data.u32);
+            // Ανάγνωση όσων δεδομένων υπάρχουν, μέχρι EAGAIN ή το όριο ανά ειδοποίηση
+            for (int reads = 0; reads < MAX_READS_PER_SOURCE; reads++) {
+                ssize_t bytes_read = readers[i].readFrom(splitterPipeDescriptors[i]);
+                stats.readCalls++;
+                if (bytes_read > 0) stats.bytesRead += bytes_read;
+
+                if (bytes_read == -1) {     // Έλεγχος σφαλμάτων ανάγνωσης
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) break;     // Το FIFO άδειασε
+                    std::perror("read");
+                    return false;
+                }
+                if (bytes_read == 0) {      // Ανάγνωση EOF, το FIFO είναι πλέον κλειστό
+                    if (!readers[i].empty()) {
+                        std::cerr << "Builder " << params.builderID << ": truncated record from splitter " << i << std::endl;
+                        return false;
+                    }
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, splitterPipeDescriptors[i], NULL);
+                    epochs.close(i);
+                    activeCount--;
+                    break;
+                }
+
+                TraceSpan span("count");
+                if (!processRecords(readers[i], counts, epochs.epoch(i), stats)) {
+                    std::cerr << "Builder " << params.builderID << ": invalid data from splitter " << i << std::endl;
+                    return false;
+                }
             }
+            if (!epochs.update()) return false;
         }
     }
+    delete[] events;
+    close(epollFd);
+    delete[] readers;
+
+    // Κλείσιμο όλων των pipes προς τους splitters
+    for (size_t i = 0; i < splitterPipeDescriptors.get_size(); i++) close(splitterPipeDescriptors[i]);
+    return true;
 }
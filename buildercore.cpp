@@ -0,0 +1,136 @@
+// buildercore.cpp
+#include <cstring>
+#include <algorithm>
+#include "buildercore.hpp"
+#include "heap.hpp"
+
+EpochTracker::EpochTracker(int numOfStreams, EpochListener* listener) : published(0), listener(listener) {
+    for (int i = 0; i < numOfStreams; i++) {
+        epochs.push_back(0);
+        closed.push_back(false);
+    }
+}
+
+bool EpochTracker::update() {
+    if (listener == nullptr) return true;
+
+    // Η μικρότερη εποχή μεταξύ των ανοιχτών ροών
+    bool any = false;
+    uint64_t lowest = 0;
+    for (size_t i = 0; i < epochs.get_size(); i++) {
+        if (closed[i]) continue;
+        if (!any || epochs[i] < lowest) lowest = epochs[i];
+        any = true;
+    }
+    if (!any || lowest <= published) return true;
+    published = lowest;
+    return listener->epochComplete(lowest);
+}
+
+bool ranksBefore(const RankedWord& a, const RankedWord& b) {
+    if (a.count != b.count) return a.count > b.count;
+    return strcmp(a.word, b.word) < 0;
+}
+
+// Σύγκριση για σωρό ελαχίστου: στην κορυφή βρίσκεται η χειρότερη από τις κρατημένες λέξεις
+struct WorstOnTop {
+    bool operator()(const RankedWord& a, const RankedWord& b) const { return ranksBefore(b, a); }
+};
+
+// Μια λέξη του πίνακα ως υποψήφια για τα topK
+static RankedWord rankedAt(const WordMap& map, size_t i) {
+    const WordMap::Entry& e = map.entry(i);
+    RankedWord wc = { map.word(e), e.length, e.count, 0 };
+    return wc;
+}
+
+static RankedWord rankedAt(const SpaceSaving& sketch, size_t i) {
+    const SpaceSaving::Counter& c = sketch.counter(i);
+    RankedWord wc = { c.word, c.length, c.count, c.error };
+    return wc;
+}
+
+template <typename Counts>
+static Vector<RankedWord> selectTopKOf(const Counts& counts, size_t topK) {
+    Heap<RankedWord, WorstOnTop> heap((WorstOnTop()));
+
+    for (size_t i = 0; i < counts.get_size() && topK > 0; i++) {
+        RankedWord wc = rankedAt(counts, i);
+        if (heap.get_size() < topK) {
+            heap.push(wc);
+        } else if (ranksBefore(wc, heap.top())) {   // Καλύτερη από τη χειρότερη κρατημένη λέξη
+            heap.replaceTop(wc);
+        }
+    }
+
+    // Εξαγωγή από τη χειρότερη προς την καλύτερη και αντιστροφή της σειράς
+    Vector<RankedWord> result;
+    result.reserve(heap.get_size());
+    while (!heap.empty()) {
+        result.push_back(heap.top());
+        heap.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+Vector<RankedWord> selectTopK(const WordMap& map, size_t topK) {
+    return selectTopKOf(map, topK);
+}
+
+Vector<RankedWord> selectTopK(const SpaceSaving& sketch, size_t topK) {
+    return selectTopKOf(sketch, topK);
+}
+
+// Κρατά τις topK λέξεις της συγχώνευσης των runs, με δικά τους αντίγραφα των λέξεων
+class TopKSink : public MergeSink {
+private:
+    Heap<RankedWord, WorstOnTop> heap;
+    size_t topK;
+
+public:
+    explicit TopKSink(size_t topK) : heap((WorstOnTop())), topK(topK) {}
+
+    ~TopKSink() {
+        while (!heap.empty()) {
+            delete[] heap.top().word;
+            heap.pop();
+        }
+    }
+
+    void word(const char* word, size_t length, long long count) override {
+        if (topK == 0) return;
+        RankedWord wc = { word, length, count, 0 };
+        if (heap.get_size() == topK) {
+            if (!ranksBefore(wc, heap.top())) return;
+            delete[] heap.top().word;
+            heap.pop();
+        }
+        char* copy = new char[length + 1];
+        std::memcpy(copy, word, length);
+        copy[length] = '\0';
+        wc.word = copy;
+        heap.push(wc);
+    }
+
+    // Μεταφορά των λέξεων στον πίνακα table
+    void moveTo(WordMap& table) {
+        while (!heap.empty()) {
+            const RankedWord& wc = heap.top();
+            table.add(wc.word, wc.length, wc.count);
+            delete[] wc.word;
+            heap.pop();
+        }
+    }
+};
+
+Vector<RankedWord> selectTopK(SpillingCounts& counts, size_t topK) {
+    // Χωρίς runs όλα τα counts είναι ακόμα στη μνήμη
+    if (counts.numOfRuns() == 0) return selectTopK(counts.inMemory(), topK);
+
+    TopKSink sink(topK);
+    WordMap& table = counts.resultTable();
+    table.clear();
+    if (counts.merge(sink)) sink.moveTo(table);
+    return selectTopK(table, topK);
+}
@@ -0,0 +1,181 @@
+#ifndef BUILDERCORE_HPP
+#define BUILDERCORE_HPP
+
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include "vector.hpp"
+#include "wordmap.hpp"
+#include "spacesaving.hpp"
+#include "spillingcounts.hpp"
+#include "wire.hpp"
+#include "ring.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+// Η εργασία ενός builder, κοινή για τη διεργασία ./builder και για τα νήματα του laxen --threads.
+
+// Δομή που χρησιμοποιείται για την αποθήκευση μιας λέξης και του πλήθους εμφάνισής της
+struct RankedWord {
+    const char* word;   // Δείκτης στη λέξη μέσα στο arena του WordMap
+    size_t length;      // Μήκος της λέξης
+    long long count;
+    long long error;    // Μέγιστη υπερεκτίμηση του count (0 στην ακριβή καταμέτρηση)
+};
+
+// Ειδοποίηση του builder όταν όλοι οι splitters έχουν στείλει τη σήμανση μιας εποχής (--follow)
+class EpochListener {
+public:
+    virtual ~EpochListener() {}
+
+    // Όλα τα δεδομένα μέχρι και την εποχή epoch έχουν μετρηθεί (false σε σφάλμα)
+    virtual bool epochComplete(uint64_t epoch) = 0;
+};
+
+// Η τελευταία σήμανση εποχής κάθε ροής ενός builder. Μια εποχή ολοκληρώνεται όταν
+// την έχουν σημάνει όλες οι ροές που δεν έχουν κλείσει.
+class EpochTracker {
+private:
+    Vector<uint64_t> epochs;
+    Vector<bool> closed;
+    uint64_t published;         // Τελευταία εποχή που αναφέρθηκε στον listener
+    EpochListener* listener;    // nullptr χωρίς --follow
+
+public:
+    EpochTracker(int numOfStreams, EpochListener* listener);
+
+    uint64_t& epoch(int stream) { return epochs[stream]; }
+    void close(int stream) { closed[stream] = true; }
+
+    // Ειδοποίηση του listener αν όλες οι ροές έχουν φτάσει σε νέα εποχή
+    bool update();
+};
+
+// Οι συναρτήσεις καταμέτρησης είναι templates ως προς τον πίνακα των counts (Counts): WordMap για
+// ακριβή καταμέτρηση, SpillingCounts για --mem-budget ή SpaceSaving για --approx. Όλοι έχουν τις add/addHashed.
+
+// Μέγιστο πλήθος αναγνώσεων από μια ροή (FIFO ανά ειδοποίηση του epoll ή δακτύλιος ανά γύρο),
+// ώστε ένας γρήγορος splitter να μην καθυστερεί την εξυπηρέτηση των υπολοίπων
+const int MAX_READS_PER_SOURCE = 8;
+
+// Καταμετρά όλες τις ολοκληρωμένες εγγραφές που έχει συγκεντρώσει ο reader μιας ροής.
+// Μια εγγραφή που κόβεται στο τέλος των δεδομένων μένει στον reader μέχρι την επόμενη ανάγνωση.
+// Οι σημάνσεις εποχής ενημερώνουν το epoch. Οι εγγραφές και οι λέξεις προστίθενται στο stats.
+template <typename Counts>
+bool processRecords(WireReader& reader, Counts& counts, uint64_t& epoch, ProcessStats& stats);
+
+// Καταμέτρηση των ροών των δακτυλίων (ένας ανά splitter) μέχρι να κλείσουν όλες.
+// Όταν κανένας δακτύλιος δεν έχει δεδομένα, ο builder περιμένει στο κουδούνι του.
+// Ο listener (προαιρετικός) ειδοποιείται για κάθε ολοκληρωμένη εποχή. Οι αναγνώσεις και ο χρόνος
+// αναμονής στο κουδούνι προστίθενται στο stats.
+template <typename Counts>
+bool countFromRings(Vector<SpscRing*>& rings, Doorbell& doorbell, Counts& counts, EpochListener* listener, ProcessStats& stats);
+
+// Σειρά κατάταξης: φθίνουσα ως προς το count, και αλφαβητικά για ίσα counts
+bool ranksBefore(const RankedWord& a, const RankedWord& b);
+
+// Επιλογή των topK λέξεων σε O(n log K) με σωρό μεγέθους K.
+// Το αποτέλεσμα επιστρέφεται ταξινομημένο με τη σειρά του ranksBefore.
+Vector<RankedWord> selectTopK(const WordMap& map, size_t topK);
+Vector<RankedWord> selectTopK(const SpaceSaving& sketch, size_t topK);
+
+// Με --mem-budget οι λέξεις προκύπτουν από συγχώνευση των runs (τα runs του counts αλλάζουν με compact).
+// Οι δείκτες του αποτελέσματος δείχνουν στο resultTable() του counts, μέχρι την επόμενη κλήση.
+Vector<RankedWord> selectTopK(SpillingCounts& counts, size_t topK);
+
+// Υλοποιήσεις συναρτήσεων template
+
+template <typename Counts>
+bool processRecords(WireReader& reader, Counts& counts, uint64_t& epoch, ProcessStats& stats) {
+    WireRecord record;
+    WireStatus status;
+    while ((status = reader.next(record)) == WIRE_RECORD || status == WIRE_MARK) {
+        if (status == WIRE_MARK) {
+            epoch = record.count;
+            continue;
+        }
+        stats.records++;
+        stats.words += static_cast<long long>(record.count);
+        if (reader.hasHashes()) {
+            // Χρήση της τιμής κατακερματισμού του splitter, αν τη στέλνει
+            counts.addHashed(record.word, record.length, record.hash, record.count);
+        } else {
+            counts.add(record.word, record.length, record.count);
+        }
+    }
+    return status == WIRE_NEED_MORE;
+}
+
+template <typename Counts>
+bool countFromRings(Vector<SpscRing*>& rings, Doorbell& doorbell, Counts& counts, EpochListener* listener, ProcessStats& stats) {
+    int numOfRings = static_cast<int>(rings.get_size());
+    EpochTracker epochs(numOfRings, listener);
+    // Ένας αποκωδικοποιητής ανά δακτύλιο, αφού οι εγγραφές μπορεί να κοπούν στο όριο δύο αναγνώσεων
+    WireReader* readers = new WireReader[numOfRings];
+    bool* finished = new bool[numOfRings];
+    for (int i = 0; i < numOfRings; i++) finished[i] = false;
+
+    bool ok = true;
+    int activeCount = numOfRings;   // Αριθμός δακτυλίων που δεν έχουν κλείσει
+    while (ok && activeCount > 0) {
+        bool progress = false;
+        for (int i = 0; ok && i < numOfRings; i++) {
+            if (finished[i]) continue;
+
+            // Ανάγνωση απευθείας στον buffer του reader, μέχρι να αδειάσει ο δακτύλιος ή το όριο ανά γύρο
+            for (int reads = 0; reads < MAX_READS_PER_SOURCE; reads++) {
+                size_t available;
+                char* space = readers[i].prepare(64 * 1024, available);
+                size_t bytes_read = rings[i]->read(space, available);
+                if (bytes_read == 0) break;
+                readers[i].commit(bytes_read);
+                progress = true;
+                stats.readCalls++;
+                stats.bytesRead += static_cast<long long>(bytes_read);
+
+                TraceSpan span("count");
+                if (!processRecords(readers[i], counts, epochs.epoch(i), stats)) {
+                    std::cerr << "Builder: invalid data from splitter " << i << std::endl;
+                    ok = false;
+                    break;
+                }
+            }
+
+            if (ok && rings[i]->finished()) {
+                if (!readers[i].empty()) {
+                    std::cerr << "Builder: truncated record from splitter " << i << std::endl;
+                    ok = false;
+                }
+                finished[i] = true;
+                epochs.close(i);
+                activeCount--;
+                progress = true;
+            }
+            if (ok && !epochs.update()) ok = false;
+        }
+
+        if (!ok || progress || activeCount == 0) continue;
+
+        // Κανένας δακτύλιος δεν είχε δεδομένα: δήλωση αναμονής και τελικός έλεγχος πριν τον ύπνο,
+        // ώστε ένα χτύπημα μεταξύ του ελέγχου και της αναμονής να μη χαθεί
+        uint32_t sequence = doorbell.prepareWait();
+        bool pending = false;
+        for (int i = 0; i < numOfRings && !pending; i++) {
+            if (!finished[i] && rings[i]->pending()) pending = true;
+        }
+        if (pending) {
+            doorbell.cancelWait();
+        } else {
+            TraceSpan span("wait");
+            double start = clockSeconds(CLOCK_MONOTONIC);
+            doorbell.wait(sequence);
+            stats.readBlocked += clockSeconds(CLOCK_MONOTONIC) - start;
+        }
+    }
+
+    delete[] finished;
+    delete[] readers;
+    return ok;
+}
+
+#endif // BUILDERCORE_HPP
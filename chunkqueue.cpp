@@ -0,0 +1,96 @@
+// chunkqueue.cpp
+#include <cstdio>
+#include <new>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "chunkqueue.hpp"
+
+ChunkQueue::~ChunkQueue() {
+    if (header != nullptr) munmap(header, sizeof(ChunkQueueHeader));
+}
+
+bool ChunkQueue::create(long long startByte, long long endByte, long long chunkBytes, int fd) {
+    void* mapped;
+    if (fd >= 0) {
+        if (ftruncate(fd, static_cast<off_t>(sizeof(ChunkQueueHeader))) == -1) {
+            std::perror("ftruncate chunk queue");
+            return false;
+        }
+        mapped = mmap(NULL, sizeof(ChunkQueueHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    } else {
+        mapped = mmap(NULL, sizeof(ChunkQueueHeader), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (mapped == MAP_FAILED) {
+        std::perror("mmap chunk queue");
+        return false;
+    }
+
+    header = new (mapped) ChunkQueueHeader;
+    header->magic = CHUNK_QUEUE_MAGIC;
+    header->startByte = startByte;
+    header->endByte = endByte;
+    header->chunkBytes = chunkBytes;
+    header->next.store(0);
+    return true;
+}
+
+bool ChunkQueue::attach(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        std::perror("fstat chunk queue");
+        return false;
+    }
+    if (static_cast<size_t>(st.st_size) != sizeof(ChunkQueueHeader)) {
+        std::fprintf(stderr, "Invalid chunk queue size\n");
+        return false;
+    }
+    void* mapped = mmap(NULL, sizeof(ChunkQueueHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        std::perror("mmap chunk queue");
+        return false;
+    }
+    header = static_cast<ChunkQueueHeader*>(mapped);
+    if (header->magic != CHUNK_QUEUE_MAGIC || header->chunkBytes <= 0) {
+        std::fprintf(stderr, "Invalid chunk queue\n");
+        return false;
+    }
+    return true;
+}
+
+bool ChunkQueue::claim(int fd, long long& start, long long& end) {
+    // Τα υπόλοιπα πεδία δεν αλλάζουν μετά τη δημιουργία, οπότε αρκεί ένας χαλαρός ατομικός δρομέας
+    uint64_t index = header->next.fetch_add(1, std::memory_order_relaxed);
+    long long chunkBytes = header->chunkBytes;
+    long long regionBytes = header->endByte - header->startByte;
+    if (index >= static_cast<uint64_t>((regionBytes + chunkBytes - 1) / chunkBytes)) return false;
+
+    long long nominal = header->startByte + static_cast<long long>(index) * chunkBytes;
+    // Η snapOffset είναι μονότονη, οπότε end >= start και το end ενός τμήματος είναι το start του επόμενου
+    start = index == 0 ? header->startByte : snapOffset(fd, nominal, header->endByte);
+    end = nominal + chunkBytes >= header->endByte ? header->endByte : snapOffset(fd, nominal + chunkBytes, header->endByte);
+    return true;
+}
+
+long long snapOffset(int fd, long long offset, long long fileSize) {
+    const size_t window_size = 64 * 1024;
+    char buffer[window_size];
+
+    // Το όριο είναι ακριβώς μετά τον πρώτο διαχωριστή από το offset και μετά, χωρίς προτίμηση στο '\n':
+    // έτσι η snapOffset είναι μονότονη ως προς το offset και τα τμήματα της ChunkQueue, που υπολογίζουν
+    // ανεξάρτητα τα όριά τους, δεν επικαλύπτονται. Το πρώτο παράθυρο είναι μικρό, αφού συνήθως ένας
+    // διαχωριστής βρίσκεται κοντά, και διπλασιάζεται σε κάθε επανάληψη.
+    size_t window = 4096;
+    long long position = offset;
+    while (position < fileSize) {
+        ssize_t bytes_read = pread(fd, buffer, window, position);
+        if (bytes_read <= 0) break;
+
+        for (ssize_t i = 0; i < bytes_read; i++) {
+            if (buffer[i] == '\n' || buffer[i] == ' ' || buffer[i] == '\t') return position + i + 1;
+        }
+        position += bytes_read;
+        if (window < window_size) window *= 2;
+    }
+    return fileSize;
+}
@@ -0,0 +1,55 @@
+#ifndef CHUNKQUEUE_HPP
+#define CHUNKQUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+// Κεφαλίδα της ουράς τμημάτων στη μνήμη που μοιράζονται η ρίζα και οι splitters
+struct ChunkQueueHeader {
+    uint32_t magic;
+    long long startByte;                    // Αρχή της περιοχής της εισόδου που μοιράζεται
+    long long endByte;                      // Ένα μετά το τέλος της περιοχής
+    long long chunkBytes;                   // Ονομαστικό μέγεθος τμήματος
+    alignas(64) std::atomic<uint64_t> next; // Δείκτης του επόμενου τμήματος προς διεκδίκηση
+};
+
+const uint32_t CHUNK_QUEUE_MAGIC = 0x4c58434b;  // "LXCK"
+
+// Δυναμική κατανομή της εισόδου στους splitters: η περιοχή [startByte, endByte) χωρίζεται σε πολλά
+// μικρά τμήματα και κάθε splitter διεκδικεί το επόμενο με ένα fetch_add στον κοινό δρομέα, μόλις
+// τελειώσει το προηγούμενο. Έτσι οι γρήγοροι splitters παίρνουν περισσότερα τμήματα και ο συνολικός
+// χρόνος ακολουθεί τη μέση ταχύτητα αντί για τον πιο αργό splitter.
+//
+// Τα όρια των τμημάτων δεν αποθηκεύονται: το τμήμα i είναι [snap(start + i * chunk), snap(start + (i + 1) * chunk)),
+// όπου snap η snapOffset. Κάθε splitter υπολογίζει τα δύο όρια του τμήματος που διεκδίκησε από το ίδιο αρχείο,
+// οπότε διαδοχικά τμήματα συμφωνούν στο κοινό τους όριο χωρίς προεπεξεργασία από τη ρίζα.
+// Γι' αυτό η κοινή κεφαλίδα κρατά μόνο τον ατομικό δρομέα και την περιοχή [startByte, endByte).
+class ChunkQueue {
+private:
+    ChunkQueueHeader* header;
+
+    ChunkQueue(const ChunkQueue&);              // Δεν επιτρέπεται αντιγραφή
+    ChunkQueue& operator=(const ChunkQueue&);
+
+public:
+    ChunkQueue() : header(nullptr) {}
+    ~ChunkQueue();
+
+    // Δημιουργία και αρχικοποίηση. Με fd >= 0 η ουρά τοποθετείται στο αρχείο (π.χ. memfd)
+    // ώστε να μπορούν να την αντιστοιχίσουν άλλες διεργασίες με την attach().
+    bool create(long long startByte, long long endByte, long long chunkBytes, int fd);
+
+    // Αντιστοίχιση μιας ουράς που έχει δημιουργήσει άλλη διεργασία
+    bool attach(int fd);
+
+    // Διεκδίκηση του επόμενου τμήματος [start, end) του αρχείου fd (false όταν έχουν μοιραστεί όλα).
+    // Ένα τμήμα μπορεί να είναι κενό, αν μια γραμμή χωρίς κενά καλύπτει όλο το ονομαστικό του διάστημα.
+    bool claim(int fd, long long& start, long long& end);
+};
+
+// Μετακινεί μια θέση του αρχείου ακριβώς μετά τον επόμενο διαχωριστή (' ', '\t' ή '\n').
+// Για offset1 <= offset2 ισχύει snapOffset(offset1) <= snapOffset(offset2).
+long long snapOffset(int fd, long long offset, long long fileSize);
+
+#endif // CHUNKQUEUE_HPP
@@ -0,0 +1,210 @@
+// exclusionset.cpp
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "exclusionset.hpp"
+#include "wordmap.hpp"
+
+ExclusionSet::ExclusionSet() : image(nullptr), imageSize(0), mapped(false), header(nullptr), slots(nullptr), strings(nullptr) {
+    // Κενό σύνολο: όλες οι αναζητήσεις απορρίπτονται από τη μάσκα μηκών
+    Vector<char*> none;
+    build(none);
+}
+
+ExclusionSet::~ExclusionSet() {
+    release();
+}
+
+void ExclusionSet::release() {
+    if (mapped) {
+        munmap(image, imageSize);
+    } else {
+        delete[] image;
+    }
+    image = nullptr;
+    imageSize = 0;
+    mapped = false;
+}
+
+void ExclusionSet::build(const Vector<char*>& words) {
+    // Συντελεστής φόρτωσης το πολύ 1/2
+    uint32_t slotCount = 16;
+    while (slotCount < 2 * words.get_size()) slotCount *= 2;
+
+    size_t stringsSize = 0;
+    for (size_t i = 0; i < words.get_size(); i++) stringsSize += strlen(words[i]) + 1;
+
+    size_t slotsOffset = sizeof(Header);
+    size_t stringsOffset = slotsOffset + slotCount * sizeof(Slot);
+    size_t size = stringsOffset + stringsSize;
+
+    // Μηδενισμένο image: όλες οι θέσεις ξεκινούν κενές
+    char* newImage = new char[size]();
+    Header* newHeader = reinterpret_cast<Header*>(newImage);
+    Slot* newSlots = reinterpret_cast<Slot*>(newImage + slotsOffset);
+    char* newStrings = newImage + stringsOffset;
+    newHeader->magic = EXCLUSION_MAGIC;
+    newHeader->slotCount = slotCount;
+    newHeader->lengthMask = 0;
+
+    size_t used = 0;
+    uint32_t mask = slotCount - 1;
+    for (size_t i = 0; i < words.get_size(); i++) {
+        size_t length = strlen(words[i]);
+        if (length == 0) continue;
+        uint64_t hash = wordHash(words[i], length);
+
+        // Linear probing μέχρι κενή θέση ή την ίδια λέξη
+        uint32_t pos = hash & mask;
+        bool duplicate = false;
+        while (newSlots[pos].length != 0) {
+            const Slot& s = newSlots[pos];
+            if (s.hash == hash && s.length == length && memcmp(newStrings + s.offset, words[i], length) == 0) {
+                duplicate = true;
+                break;
+            }
+            pos = (pos + 1) & mask;
+        }
+        if (duplicate) continue;
+
+        memcpy(newStrings + used, words[i], length + 1);
+        newSlots[pos].hash = hash;
+        newSlots[pos].offset = static_cast<uint32_t>(used);
+        newSlots[pos].length = static_cast<uint32_t>(length);
+        newHeader->lengthMask |= lengthBit(length);
+        used += length + 1;
+    }
+
+    release();
+    image = newImage;
+    imageSize = size;
+    header = newHeader;
+    slots = newSlots;
+    strings = newStrings;
+}
+
+bool ExclusionSet::contains(const char* word, size_t length) const {
+    // Γρήγορη απόρριψη με βάση το μήκος, πριν από τον υπολογισμό της τιμής κατακερματισμού
+    if ((header->lengthMask & lengthBit(length)) == 0) return false;
+    return containsHashed(word, length, wordHash(word, length));
+}
+
+bool ExclusionSet::containsHashed(const char* word, size_t length, uint64_t hash) const {
+    // Γρήγορη απόρριψη με βάση το μήκος
+    if ((header->lengthMask & lengthBit(length)) == 0) return false;
+
+    uint32_t mask = header->slotCount - 1;
+    uint32_t pos = hash & mask;
+    while (slots[pos].length != 0) {
+        const Slot& s = slots[pos];
+        if (s.hash == hash && s.length == length && memcmp(strings + s.offset, word, length) == 0) return true;
+        pos = (pos + 1) & mask;
+    }
+    return false;
+}
+
+// Ανάγνωση των λέξεων του αρχείου εξαιρέσεων σε πίνακα
+static bool vectorExclusionWords(const char* exclusionFile, Vector<char*>& exclusionWords) {
+    // Άνοιγμα του αρχείου εξαιρέσεων με open
+    int file_fd = open(exclusionFile, O_RDONLY);
+    if (file_fd == -1) {  // Έλεγχος αποτυχίας ανοίγματος
+        std::perror("open exclusion file");
+        return false;
+    }
+
+    // Μετατροπή του file descriptor σε FILE* για χρήση με fgets
+    FILE* file = fdopen(file_fd, "r");
+    if (file == NULL) {  // Έλεγχος αποτυχίας μετατροπής
+        std::perror("fdopen");
+        close(file_fd);
+        return false;
+    }
+
+    const size_t buffer_size = 256;
+    char buffer[buffer_size];
+
+    // Ανάγνωση του αρχείου γραμμή προς γραμμή
+    while (fgets(buffer, buffer_size, file) != NULL) {
+        // Αφαίρεση του χαρακτήρα νέας γραμμής στο τέλος (αν υπάρχει)
+        size_t len = strlen(buffer);
+        if (len > 0 && buffer[len - 1] == '\n') {
+            buffer[len - 1] = '\0';
+        }
+
+        // Διαχωρισμός της γραμμής σε λέξεις
+        char* token = strtok(buffer, " \t");
+        while (token != NULL) {
+            // Δημιουργία αντιγράφου της λέξης
+            char* word = new char[strlen(token) + 1];
+            std::strcpy(word, token);
+
+            exclusionWords.push_back(word);  // Προσθήκη της λέξης στον Vector
+
+            token = strtok(NULL, " \t");    // Επόμενο toke
+        }
+    }
+
+    fclose(file); // Κλείσιμο του αρχείου (κλείνει και το file_fd)
+    return true;
+}
+
+bool ExclusionSet::loadFile(const char* filename) {
+    Vector<char*> words;
+    bool ok = vectorExclusionWords(filename, words);
+    build(words);   // Σε αποτυχία το σύνολο μένει με όσες λέξεις διαβάστηκαν
+    // Απελευθέρωση της μνήμης για τη λίστα εξαιρέσεων
+    for (size_t i = 0; i < words.get_size(); ++i) {
+        delete[] words[i];
+    }
+    return ok;
+}
+
+bool ExclusionSet::mapImage(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        std::perror("fstat exclusion image");
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size < sizeof(Header)) return false;
+
+    void* addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        std::perror("mmap exclusion image");
+        return false;
+    }
+
+    // Έλεγχος ότι το image είναι πλήρες πριν αντικαταστήσει το τρέχον σύνολο
+    const Header* h = static_cast<const Header*>(addr);
+    uint32_t count = h->slotCount;
+    if (h->magic != EXCLUSION_MAGIC || count == 0 || (count & (count - 1)) != 0 ||
+        sizeof(Header) + static_cast<size_t>(count) * sizeof(Slot) > size) {
+        munmap(addr, size);
+        return false;
+    }
+
+    release();
+    image = static_cast<char*>(addr);
+    imageSize = size;
+    mapped = true;
+    header = h;
+    slots = reinterpret_cast<const Slot*>(image + sizeof(Header));
+    strings = image + sizeof(Header) + count * sizeof(Slot);
+    return true;
+}
+
+bool ExclusionSet::writeImage(int fd) const {
+    size_t written = 0;
+    while (written < imageSize) {
+        ssize_t n = write(fd, image + written, imageSize - written);
+        if (n == -1) {
+            std::perror("write exclusion image");
+            return false;
+        }
+        written += n;
+    }
+    return true;
+}
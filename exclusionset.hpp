@@ -0,0 +1,74 @@
+#ifndef EXCLUSIONSET_HPP
+#define EXCLUSIONSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "vector.hpp"
+
+const uint32_t EXCLUSION_MAGIC = 0x5845584c;    // "LXEX"
+
+// Σύνολο λέξεων εξαιρέσεων με έλεγχο μέλους σε O(1).
+//
+// Όλο το σύνολο βρίσκεται σε ένα συνεχόμενο κομμάτι μνήμης (image):
+//     κεφαλίδα (ExclusionSet::Header)
+//     πίνακας θέσεων ανοιχτής διευθυνσιοδότησης (ExclusionSet::Slot, linear probing)
+//     τα bytes των λέξεων
+// Οι θέσεις κρατούν την τιμή wordHash και το μήκος κάθε λέξης, ώστε η σύγκριση των bytes
+// να γίνεται μόνο όταν ταιριάζουν και τα δύο. Μια μάσκα με τα μήκη των λέξεων
+// απορρίπτει αμέσως όσες λέξεις έχουν μήκος που δεν υπάρχει στο σύνολο.
+// Το image δεν περιέχει δείκτες, οπότε μπορεί να γραφτεί σε αρχείο (π.χ. memfd)
+// και να χρησιμοποιηθεί απευθείας από άλλες διεργασίες μέσω mmap.
+class ExclusionSet {
+public:
+    struct Header {
+        uint32_t magic;         // EXCLUSION_MAGIC
+        uint32_t slotCount;     // Πλήθος θέσεων (πάντα δύναμη του 2)
+        uint64_t lengthMask;    // Bit min(μήκος, 63) για κάθε λέξη του συνόλου
+    };
+
+    struct Slot {
+        uint64_t hash;          // Τιμή wordHash της λέξης
+        uint32_t offset;        // Θέση της λέξης μετά τον πίνακα θέσεων
+        uint32_t length;        // Μήκος της λέξης (0 = κενή θέση)
+    };
+
+private:
+    char* image;                // Το image του συνόλου (δικό μας ή αντιστοιχισμένο με mmap)
+    size_t imageSize;
+    bool mapped;                // Το image προέρχεται από mmap και ελευθερώνεται με munmap
+    const Header* header;
+    const Slot* slots;
+    const char* strings;
+
+    ExclusionSet(const ExclusionSet&);              // Δεν επιτρέπεται αντιγραφή
+    ExclusionSet& operator=(const ExclusionSet&);
+
+    static uint64_t lengthBit(size_t length) { return 1ULL << (length < 63 ? length : 63); }
+
+    // Αποδέσμευση του τρέχοντος image
+    void release();
+
+public:
+    ExclusionSet();
+    ~ExclusionSet();
+
+    // Κατασκευή του συνόλου από λίστα λέξεων (οι διπλότυπες αγνοούνται)
+    void build(const Vector<char*>& words);
+
+    // Ανάγνωση του αρχείου εξαιρέσεων (λέξεις χωρισμένες με κενά ή αλλαγές γραμμής) και κατασκευή του συνόλου
+    bool loadFile(const char* filename);
+
+    // Χρήση ενός έτοιμου image από το fd μέσω mmap μόνο για ανάγνωση (false αν δεν είναι έγκυρο)
+    bool mapImage(int fd);
+
+    // Εγγραφή του image στο fd
+    bool writeImage(int fd) const;
+
+    // true αν η λέξη ανήκει στο σύνολο
+    bool contains(const char* word, size_t length) const;
+
+    // Όπως η contains, με ήδη υπολογισμένη την τιμή wordHash της λέξης
+    bool containsHashed(const char* word, size_t length, uint64_t hash) const;
+};
+
+#endif // EXCLUSIONSET_HPP
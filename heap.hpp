@@ -0,0 +1,94 @@
+#ifndef HEAP_HPP
+#define HEAP_HPP
+
+#include <stdexcept> // Για διαχείριση εξαιρέσεων
+#include "vector.hpp"
+
+// Δυαδικός σωρός πάνω σε Vector<T>.
+// Η συνάρτηση σύγκρισης comp(a, b) επιστρέφει true όταν το a πρέπει να βρίσκεται πιο κοντά στην κορυφή από το b.
+template <typename T, typename Compare>
+class Heap {
+private:
+    Vector<T> items;    // Τα στοιχεία του σωρού σε διάταξη πίνακα
+    Compare comp;       // Συνάρτηση σύγκρισης
+
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+
+public:
+    explicit Heap(Compare compare) : comp(compare) {}
+
+    void push(const T& value);
+    void pop();
+    void replaceTop(const T& value);   // Αντικατάσταση της κορυφής (ισοδύναμο με pop + push)
+
+    const T& top() const;
+    size_t get_size() const { return items.get_size(); }
+    bool empty() const { return items.get_size() == 0; }
+};
+
+// Υλοποιήσεις συναρτήσεων template
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (!comp(items[index], items[parent])) break;
+        T temp = items[index];
+        items[index] = items[parent];
+        items[parent] = temp;
+        index = parent;
+    }
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::siftDown(size_t index) {
+    size_t n = items.get_size();
+    while (true) {
+        size_t best = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < n && comp(items[left], items[best])) best = left;
+        if (right < n && comp(items[right], items[best])) best = right;
+        if (best == index) break;
+        T temp = items[index];
+        items[index] = items[best];
+        items[best] = temp;
+        index = best;
+    }
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::push(const T& value) {
+    items.push_back(value);
+    siftUp(items.get_size() - 1);
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::pop() {
+    if (items.get_size() == 0) {
+        throw std::out_of_range("Ο σωρός είναι άδειος");
+    }
+    items[0] = items[items.get_size() - 1];
+    items.pop_back();
+    if (items.get_size() > 0) siftDown(0);
+}
+
+template <typename T, typename Compare>
+void Heap<T, Compare>::replaceTop(const T& value) {
+    if (items.get_size() == 0) {
+        throw std::out_of_range("Ο σωρός είναι άδειος");
+    }
+    items[0] = value;
+    siftDown(0);
+}
+
+template <typename T, typename Compare>
+const T& Heap<T, Compare>::top() const {
+    if (items.get_size() == 0) {
+        throw std::out_of_range("Ο σωρός είναι άδειος");
+    }
+    return items[0];
+}
+
+#endif // HEAP_HPP
@@ -3,13 +3,34 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include <sys/stat.h>  
+#include <sys/mman.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <time.h>
+#include <signal.h>
 #include <fcntl.h>
 #include <cstdlib>
 #include <cstring>
 #include <errno.h>
 #include <iomanip>
+#include <climits>
 #include "list.hpp"
 #include "vector.hpp"
+#include "heap.hpp"
+#include "reader.hpp"
+#include "wire.hpp"
+#include "exclusionset.hpp"
+#include "tokenizer.hpp"
+#include "ring.hpp"
+#include "splittercore.hpp"
+#include "buildercore.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "chunkqueue.hpp"
 
 // Δομή Παραμέτρων
 struct Parameters {
@@ -19,6 +40,19 @@ struct Parameters {
     int numOfSplitter;
     int numOfBuilders;
     int topK;
+    char readerBackend[16];     // Backend ανάγνωσης εισόδου των splitters (mmap, pread, uring)
+    int batchSize;              // Μέγεθος πλαισίου εξόδου των splitters προς τους builders
+    bool wireHashes;            // Οι splitters στέλνουν και την τιμή κατακερματισμού κάθε λέξης
+    long long combineBytes;     // Όριο μνήμης του combiner κάθε splitter (0 = χωρίς combiner)
+    char tokenizerKernel[16];   // Πυρήνας τμηματοποίησης των splitters (auto, scalar, sse2, avx2)
+    bool threads;               // Εκτέλεση των splitters και builders ως νήματα της ίδιας διεργασίας
+    char transport[8];          // Μεταφορά splitter -> builder μεταξύ διεργασιών (fifo, shm)
+    double followInterval;      // Διάστημα ανανέωσης των αποτελεσμάτων σε δευτερόλεπτα (--follow, 0 = χωρίς)
+    double approxEpsilon;       // Προσεγγιστική καταμέτρηση στους builders με σφάλμα <= epsilon * N (--approx, 0 = ακριβής)
+    long long memBudget;        // Όριο μνήμης των counts κάθε builder πριν την εγγραφή τους σε run (--mem-budget, 0 = χωρίς όριο)
+    char reportFormat[8];       // Αναφορά της εκτέλεσης σε μορφή json ή csv (--report, κενό = χωρίς)
+    char traceFile[256];        // Αρχείο με τις φάσεις όλων των διεργασιών σε μορφή Chrome trace (--trace, κενό = χωρίς)
+    long long chunkBytes;       // Μέγεθος των τμημάτων που διεκδικούν δυναμικά οι splitters (--chunk, 0 = ένα σταθερό τμήμα ανά splitter, -1 = ανάλογα με την είσοδο)
 };
 
 // Δομή για αποθήκευση file descriptors ενός pipe
@@ -28,53 +62,164 @@ struct PipeFD {
 
 // Δομή που χρησιμοποιείται για την αποθήκευση μιας λέξης και του πλήθους εμφάνισής της
 struct WordCount {
-    char word[64];
-    int count;
+    char* word;         // Αντίγραφο της λέξης (αποδεσμεύεται με freeResults)
+    long long count;
+    long long error;    // Μέγιστη υπερεκτίμηση του count (--approx)
 };
 
-// Δομή για την αποθήκευση χρόνων εκτέλεσης
-struct Time {
-    double real_time;
-    double cpu_time;
+// Ροή αποτελεσμάτων ενός builder: αποκωδικοποιητής και τρέχουσα (κεφαλή) εγγραφή
+struct BuilderStream {
+    int fd;                 // File descriptor του named pipe
+    WireReader reader;      // Αποκωδικοποιητής του πρωτοκόλλου
+    bool eof;               // Έχει κλείσει το pipe από τον builder
+    bool waiting;           // Η συγχώνευση περιμένει δεδομένα για την επόμενη κεφαλή της ροής
+    WordCount head;         // Τρέχουσα εγγραφή της ροής (αντίγραφο, ώστε νέες αναγνώσεις να μην την αλλοιώνουν)
+};
+
+// Αποτέλεσμα της αποκωδικοποίησης της επόμενης κεφαλής μιας ροής
+enum HeadStatus {
+    HEAD_READY,         // Η κεφαλή είναι διαθέσιμη
+    HEAD_NEED_DATA,     // Η επόμενη εγγραφή δεν έχει φτάσει ακόμα
+    HEAD_END            // Η ροή τελείωσε
 };
 
 // Δομή αποτελεσμάτων για USR σήματα
 struct USRResult {
-    int received;       // Αριθμός ληφθέντων μηνυμάτων
-    Vector<Time> times; // Χρόνοι για κάθε splitter ή builder
+    int received;               // Αριθμός ληφθέντων μηνυμάτων
+    Vector<ProcessStats> stats; // Χρόνοι και μετρητές για κάθε splitter ή builder
 };
 
 // Ανάλυση των ορισμάτων γραμμής εντολών
 Parameters parseArguments(int argc, char* argv[]); 
 
-// Μετράει τον αριθμό των γραμμών σε ένα αρχείο
-int countLines(const char* filename);
+// Χωρίζει το αρχείο σε numOfParts συνεχόμενα τμήματα bytes, με όρια ακριβώς μετά από αλλαγή γραμμής
+// ή κενό ώστε καμία λέξη να μη μοιράζεται σε δύο τμήματα. Επιστρέφει numOfParts + 1 όρια.
+// Με chunkBytes > 0 (ή -1, που γίνεται defaultChunkBytes του μεγέθους) το αρχείο δεν διαβάζεται:
+// αρκεί το fstat και επιστρέφονται μόνο τα όρια [0, μέγεθος] της ουράς τμημάτων.
+bool partitionInput(const char* filename, int numOfParts, long long& chunkBytes, Vector<long long>& boundaries);
 
-// Συνάρτηση που μετατρέπει έναν ακέραιο σε συμβολοσειρά
-const char* intToStr(int number);
+// Μέγεθος τμήματος της δυναμικής κατανομής όταν δεν δίνεται --chunk: περίπου CHUNKS_PER_SPLITTER τμήματα
+// ανά splitter, ώστε μια μικρή είσοδος να μη μοιράζεται σε ένα ή δύο μόνο τμήματα, μεταξύ 64 KB και 4 MiB
+long long defaultChunkBytes(long long inputSize, int numOfSplitter);
 
-// Συνάρτηση αναμένει να λάβει ένα συγκεκριμένο μήνυμα μέσω pipes
-USRResult waitUSR(int numOf, const List<PipeFD>& allpipeUSR, const char* acceptBuffer);
+// Ίδιος χωρισμός για το τμήμα [start, end) του ανοιχτού αρχείου fd
+void partitionRange(int fd, long long start, long long end, int numOfParts, Vector<long long>& boundaries);
 
-// Συνάρτηση που διαβάζει τις κορυφαίες λέξεις από πολλαπλούς builders μέσω pipes
-Vector<WordCount> readTopK(int numOf);
+// Θέση ακριβώς μετά την τελευταία αλλαγή γραμμής του [start, fileSize) ή start αν δεν υπάρχει.
+// Με --follow μια γραμμή που γράφεται ακόμα δεν στέλνεται στους splitters.
+long long lastSeparatorEnd(int fd, long long start, long long fileSize);
 
-// Πρότυπη συνάρτηση για την ταξινόμηση ενός Vector σε σχεση με το count
-template <typename T, typename Compare>
-void vector_sort(Vector<T>& vec, Compare comp);
+// Φτιάχνει το σύνολο εξαιρέσεων και γράφει το image του σε memfd που κληρονομούν οι splitters.
+// Επιστρέφει -1 αν δεν είναι διαθέσιμο, οπότε κάθε splitter διαβάζει μόνος του το αρχείο.
+int compileExclusionSet(const char* exclusionFile);
 
-// Εγγραφή αποτελεσμάτων στο αρχείο εξόδου 
-void writeResultsToFile(const Parameters& params, const Vector<WordCount>& vecTopK);
+// Συνάρτηση που μετατρέπει έναν ακέραιο σε συμβολοσειρά
+const char* intToStr(long long number);
+
+// Εκτέλεση με --threads: οι splitters και οι builders τρέχουν ως νήματα αυτής της διεργασίας και
+// ανταλλάσσουν τα πλαίσια του πρωτοκόλλου μέσω ενός δακτυλίου SPSC ανά ζεύγος splitter -> builder,
+// χωρίς named pipes και αντιγραφές μέσω του πυρήνα. Επιστρέφει false αν κάποιο νήμα απέτυχε.
+// Με traceFd >= 0 οι φάσεις κάθε νήματος προστίθενται στο αρχείο trace.
+bool runThreads(Parameters& params, int traceFd, Vector<WordCount>& vecTopK, USRResult& resultUSR1, USRResult& resultUSR2);
+
+// Συγχώνευση (k-way merge) ταξινομημένων λιστών λέξεων των builders μέχρι topK λέξεις. Κάθε λέξη
+// ανήκει σε έναν μόνο builder, οπότε δεν χρειάζεται άθροιση. Οι λέξεις που περνούν στο results
+// αφαιρούνται από τις λίστες, οι υπόλοιπες μένουν για αποδέσμευση από τον καλούντα.
+void mergeResults(Vector<WordCount>* const* lists, int numOfLists, size_t topK, Vector<WordCount>& results);
+
+// Βρόχος γεγονότων της ρίζας. Με ένα epoll εξυπηρετεί με τη σειρά που συμβαίνουν:
+//   - τα μηνύματα ολοκλήρωσης των splitters και των builders (χρόνοι εκτέλεσης)
+//   - τις ροές αποτελεσμάτων των builders, που συγχωνεύονται (k-way merge) καθώς φτάνουν
+//     μέχρι να συγκεντρωθούν topK λέξεις
+//   - τον τερματισμό των παιδιών (SIGCHLD μέσω signalfd και waitpid)
+// Επιστρέφει false αν κάποιο παιδί τερμάτισε με σφάλμα. Με δακτυλίους κοινής μνήμης (ringMesh), ένας
+// τέτοιος τερματισμός διακόπτει όλες τις ροές, αφού δεν υπάρχει EOF όπως στα named pipes.
+bool runEventLoop(const Parameters& params, const List<PipeFD>& allpipeUSR1, const List<PipeFD>& allpipeUSR2, int signalFd,
+                  RingMesh* ringMesh, Vector<WordCount>& vecTopK, USRResult& resultUSR1, USRResult& resultUSR2);
+
+// Βρόχος γεγονότων της ρίζας με --follow. Οι splitters και οι builders μένουν ζωντανοί όσο
+// παρακολουθείται το αρχείο εισόδου (inotify). Σε κάθε λήξη του χρονομέτρου, αν το αρχείο μεγάλωσε,
+// μόνο το νέο τμήμα [dispatchedEnd, ...) μοιράζεται στους splitters μέσω των pipes ελέγχου ως νέα εποχή.
+// Οι builders στέλνουν τα topK τους στο τέλος κάθε εποχής και η ρίζα ανανεώνει το αρχείο εξόδου.
+// Με SIGINT/SIGTERM ή αν το αρχείο διαγραφεί, μετονομαστεί ή μικρύνει, τα pipes ελέγχου κλείνουν και
+// στο vecTopK μένουν τα τελικά αποτελέσματα. Ανά εποχή επεξεργάζεται ένα μόνο τμήμα.
+bool runFollow(const Parameters& params, const List<PipeFD>& allpipeUSR1, const List<PipeFD>& allpipeUSR2, List<PipeFD>& allpipeControl,
+               int signalFd, int inputFd, long long dispatchedEnd, RingMesh* ringMesh,
+               Vector<WordCount>& vecTopK, USRResult& resultUSR1, USRResult& resultUSR2);
+
+// Ανάγνωση και καταγραφή ενός μηνύματος ολοκλήρωσης ("<acceptBuffer>-id-real-cpu key=value ...") από το fd
+void readDoneMessage(int fd, const char* acceptBuffer, USRResult& result);
+
+// Αποκωδικοποιεί την επόμενη εγγραφή της ροής στο stream.head από όσα δεδομένα έχουν ήδη διαβαστεί
+HeadStatus decodeHead(BuilderStream& stream);
+
+// Σειρά κατάταξης: φθίνουσα ως προς το count, και αλφαβητικά για ίσα counts (ίδια με των builders)
+bool ranksBefore(const WordCount& a, const WordCount& b);
+
+// Αποδέσμευση των λέξεων του vector αποτελεσμάτων
+void freeResults(Vector<WordCount>& vecTopK);
+
+// Εγγραφή αποτελεσμάτων στο αρχείο εξόδου path
+void writeResultsToFile(const Parameters& params, const char* path, const Vector<WordCount>& vecTopK);
 
 // Εκτύπωση αποτελεσμάτων στο TTY
-void printResults(const Vector<WordCount>& vecTopK, int topK, const USRResult& resultUSR1, const USRResult& resultUSR2);
+void printResults(const Parameters& params, const Vector<WordCount>& vecTopK, const USRResult& resultUSR1, const USRResult& resultUSR2);
+
+// Αναφορά της εκτέλεσης για αυτόματη επεξεργασία (--report) στο "<outputFile>.json" ή "<outputFile>.csv":
+// παράμετροι, συνολικός χρόνος, μετρικές ανισορροπίας φορτίου, top-K και οι μετρητές κάθε splitter και builder
+void writeReport(const Parameters& params, double realTime, const Vector<WordCount>& vecTopK, const USRResult& resultUSR1,
+                 const USRResult& resultUSR2);
+
+// Εγγραφή των φάσεων της ρίζας στο τέλος του αρχείου trace (--trace) και κλείσιμό του
+void finishTrace(const Parameters& params, TraceBuffer* trace, int traceFd);
 
 int main(int argc, char* argv[]) {
+    double startTime = clockSeconds(CLOCK_MONOTONIC);
+
     // Αρχικοποίηση ονομάτων αρχείων και παραμέτρων
     Parameters params = parseArguments(argc, argv);
 
+    // Με --trace η ρίζα δημιουργεί το αρχείο πριν από τα παιδιά, που προσθέτουν τις φάσεις τους
+    // πριν από το μήνυμα ολοκλήρωσης. Οι φάσεις της ρίζας γράφονται τελευταίες και κλείνουν το αρχείο.
+    int traceFd = -1;
+    TraceBuffer* trace = nullptr;
+    if (params.traceFile[0] != '\0') {
+        traceFd = createTraceFile(params.traceFile);
+        if (traceFd == -1) return 1;
+        trace = new TraceBuffer("laxen", true);
+        trace->activate();
+    }
+
+    if (params.threads) {
+        Vector<WordCount> vecTopK;
+        USRResult resultUSR1, resultUSR2;
+        bool threadsOk = runThreads(params, traceFd, vecTopK, resultUSR1, resultUSR2);
+        writeResultsToFile(params, params.outputFile, vecTopK);
+        printResults(params, vecTopK, resultUSR1, resultUSR2);
+        if (params.reportFormat[0] != '\0') {
+            writeReport(params, clockSeconds(CLOCK_MONOTONIC) - startTime, vecTopK, resultUSR1, resultUSR2);
+        }
+        freeResults(vecTopK);
+        if (trace != nullptr) finishTrace(params, trace, traceFd);
+        return threadsOk ? 0 : 2;
+    }
+
+    // Με --transport shm οι splitters στέλνουν στους builders μέσω δακτυλίων σε memfd που κληρονομούν
+    // τα παιδιά. Η ρίζα κρατά την αντιστοίχιση για να διακόψει τις ροές αν τερματίσει κάποιο παιδί.
+    bool sharedRings = strcmp(params.transport, "shm") == 0;
+    RingMesh ringMesh;
+    int ringFd = -1;
+    if (sharedRings) {
+        ringFd = memfd_create("laxen-rings", 0);    // Χωρίς FD_CLOEXEC ώστε να περάσει στα παιδιά
+        if (ringFd == -1) {
+            std::perror("memfd_create");
+            return 2;
+        }
+        if (!ringMesh.create(params.numOfSplitter, params.numOfBuilders, RingMesh::capacityFor(params.batchSize), ringFd)) return 2;
+    }
+
     Vector<char*> nameStoB;     // Αποθήκευση ονομάτων των named pipes από splitter προς builder
-    for (int ii = 0; ii < params.numOfSplitter; ii++) { 
+    for (int ii = 0; !sharedRings && ii < params.numOfSplitter; ii++) { 
         for (int jj = 0; jj < params.numOfBuilders; jj++) { 
             char fifo_path[50];
             sprintf(fifo_path, "fifo_splitter%d_builder%d", ii, jj);
@@ -107,7 +252,28 @@ int main(int argc, char* argv[]) {
 
     pid_t pid;
 
+    // Το SIGCHLD μπλοκάρεται πριν από τα fork, ώστε κανένας τερματισμός να μη χαθεί πριν φτιαχτεί το signalfd.
+    // Τα παιδιά επαναφέρουν την αρχική μάσκα πριν από το exec.
+    // Με --follow το ίδιο ισχύει για τα SIGINT/SIGTERM, που τερματίζουν ομαλά την παρακολούθηση.
+    bool follow = params.followInterval > 0;
+    sigset_t childMask, oldMask;
+    sigemptyset(&childMask);
+    sigaddset(&childMask, SIGCHLD);
+    if (follow) {
+        sigaddset(&childMask, SIGINT);
+        sigaddset(&childMask, SIGTERM);
+    }
+    if (sigprocmask(SIG_BLOCK, &childMask, &oldMask) == -1) {
+        std::perror("sigprocmask");
+        return 2;
+    }
+
     List<PipeFD> allpipeUSR2;  // Λίστα για αποθήκευση pipes επικοινωνίας USR2
+    char approxArg[32];
+    snprintf(approxArg, sizeof(approxArg), "%.17g", params.approxEpsilon);
+    char budgetArg[32];
+    snprintf(budgetArg, sizeof(budgetArg), "%lld", params.memBudget);
+    TraceSpan spawnSpan("spawn builders");
 
     for (int i = 0; i < params.numOfBuilders; i++) {
         PipeFD pipe_USR2;
@@ -124,6 +290,8 @@ int main(int argc, char* argv[]) {
             return 3;
         } else if (pid == 0) {  // Διαδικασία παιδιού
             close(pipe_USR2.fd[0]);  // Κλείνουμε το read end του pipe USR2
+            sigprocmask(SIG_SETMASK, &oldMask, NULL);
+            if (follow) setpgid(0, 0);  // Το Ctrl-C του τερματικού φτάνει μόνο στη ρίζα
 
             // Εκτέλεση του builder μέσω execl
                 execl("./builder",
@@ -132,28 +300,65 @@ int main(int argc, char* argv[]) {
                 "-id", intToStr(i), 
                 "-l", intToStr(params.numOfSplitter), 
                 "-t", intToStr(params.topK),       
+                "-R", intToStr(ringFd),
+                "-a", approxArg,
+                "-B", budgetArg,
+                "-tr", params.traceFile,
+                follow ? "-F" : (char*)NULL,
                 (char*)NULL); 
             // Αν η exec αποτύχει
             std::perror("execl");
             return 3;
         }
+        close(pipe_USR2.fd[1]);     // Το write end ανήκει μόνο στον builder
     }
     
-    // Υπολογισμός του συνολικού αριθμού γραμμών του αρχείου
-    int totalLines = countLines(params.inputFile);
-    if (totalLines < 0) {  // Έλεγχος αποτυχίας ανάγνωσης
-        std::perror("Error: Could not count lines in input file.");
+    spawnSpan.end();
+
+    // Το σύνολο εξαιρέσεων φτιάχνεται μία φορά εδώ και οι splitters το αντιστοιχίζουν μέσω mmap
+    TraceSpan exclusionSpan("compile exclusion set");
+    int exclusionFd = compileExclusionSet(params.exclusionFile);
+    exclusionSpan.end();
+
+    // Διαχωρισμός του αρχείου σε τμήματα bytes, ένα για κάθε splitter. Με --follow το αρχείο μένει
+    // ανοιχτό για τα επόμενα τμήματα και η αρχική εποχή σταματά στην τελευταία πλήρη γραμμή.
+    // Με --chunk χρειάζεται μόνο το μέγεθος του αρχείου.
+    TraceSpan partitionSpan("partition input");
+    Vector<long long> boundaries;
+    int inputFd = -1;
+    if (follow) {
+        struct stat st;
+        inputFd = open(params.inputFile, O_RDONLY | O_CLOEXEC);
+        if (inputFd == -1 || fstat(inputFd, &st) == -1) {
+            std::perror("open input file");
+            return 1;
+        }
+        long long end = lastSeparatorEnd(inputFd, 0, static_cast<long long>(st.st_size));
+        partitionRange(inputFd, 0, end, params.numOfSplitter, boundaries);
+    } else if (!partitionInput(params.inputFile, params.numOfSplitter, params.chunkBytes, boundaries)) {
+        std::cerr << "Error: Could not partition input file." << std::endl;
         return 1;
     }
-    // Υπολογισμός του αριθμού γραμμών ανά splitter
-    int linesPerSplitter = totalLines / params.numOfSplitter;
+    partitionSpan.end();
+
+    // Με --chunk οι splitters διεκδικούν τμήματα από μια κοινή ουρά σε memfd αντί για το σταθερό
+    // [boundaries[i], boundaries[i + 1]). Με --follow κάθε εποχή μοιράζεται ακόμα σε σταθερά τμήματα.
+    ChunkQueue chunkQueue;
+    int chunkFd = -1;
+    if (params.chunkBytes > 0 && !follow) {
+        chunkFd = memfd_create("laxen-chunks", 0);  // Χωρίς FD_CLOEXEC ώστε να περάσει στους splitters
+        if (chunkFd == -1) {
+            std::perror("memfd_create");
+            return 2;
+        }
+        if (!chunkQueue.create(boundaries[0], boundaries[1], params.chunkBytes, chunkFd)) return 2;
+    }
 
+    TraceSpan splitterSpan("spawn splitters");
     List<PipeFD> allpipeUSR1;       // Λίστα με pipes για επικοινωνία με τους splitters
+    List<PipeFD> allpipeControl;    // Pipes ελέγχου προς τους splitters (--follow)
 
     for (int i = 0; i < params.numOfSplitter; i++) {
-        int startLine = i * linesPerSplitter;       // Υπολογισμός αρχικής γραμμής για τον splitter
-        int endLine = (i == params.numOfSplitter - 1) ? totalLines - 1 : (startLine + linesPerSplitter - 1);    // Τελευταία γραμμή για τον τελευταίο splitter
-
         PipeFD pipe_USR1;
         if (pipe(pipe_USR1.fd) == -1) {
             perror("pipe");
@@ -161,6 +366,16 @@ int main(int argc, char* argv[]) {
         }
         allpipeUSR1.add(pipe_USR1);     // Προσθήκη του pipe στη λίστα
 
+        // Το pipe ελέγχου δημιουργείται με O_CLOEXEC ώστε κανένα άλλο παιδί να μην κρατά ανοιχτό το write end
+        PipeFD pipe_control = { { -1, -1 } };
+        if (follow) {
+            if (pipe2(pipe_control.fd, O_CLOEXEC) == -1) {
+                perror("pipe2");
+                exit(1);
+            }
+            allpipeControl.add(pipe_control);
+        }
+
         // Εκκίνηση του splitter
         pid = fork();
         if (pid < 0) { // Έλεγχος αποτυχίας fork
@@ -168,6 +383,12 @@ int main(int argc, char* argv[]) {
             return 3;
         } else if (pid == 0) {  // Διαδικασία παιδιού
             close(pipe_USR1.fd[0]);  // Κλείσιμο του read end του pipe στην παιδική διεργασία
+            sigprocmask(SIG_SETMASK, &oldMask, NULL);
+            if (follow) {
+                setpgid(0, 0);
+                fcntl(pipe_control.fd[0], F_SETFD, 0);  // Το read end περνά στον splitter μέσω exec
+            }
+            int part = chunkFd >= 0 ? 0 : i;   // Με --chunk όλοι παίρνουν όλη την είσοδο
 
             // Εκτέλεση του splitter μέσω execl
             execl("./splitter",
@@ -177,50 +398,69 @@ int main(int argc, char* argv[]) {
                 "-i", params.inputFile,        
                 "-e", params.exclusionFile,    
                 "-m", intToStr(params.numOfBuilders),   
-                "-sL", intToStr(startLine),      
-                "-eL", intToStr(endLine),        
+                "-sB", intToStr(boundaries[part]),      
+                "-eB", intToStr(boundaries[part + 1]),        
+                "-r", params.readerBackend,
+                "-b", intToStr(params.batchSize),
+                "-c", intToStr(params.combineBytes),
+                "-x", intToStr(exclusionFd),
+                "-T", params.tokenizerKernel,
+                "-R", intToStr(ringFd),
+                "-F", intToStr(pipe_control.fd[0]),
+                "-Q", intToStr(chunkFd),
+                "-tr", params.traceFile,
+                params.wireHashes ? "-H" : (char*)NULL,
                 (char*)NULL);  
             // Αν η exec αποτύχει
             std::perror("execl");
             return 3;
         }
+        close(pipe_USR1.fd[1]);     // Το write end ανήκει μόνο στον splitter
+        if (follow) close(pipe_control.fd[0]);
+    }
+    splitterSpan.end();
+    if (exclusionFd >= 0) close(exclusionFd);   // Οι splitters έχουν το δικό τους αντίγραφο του fd
+    if (ringFd >= 0) close(ringFd);             // Τα παιδιά έχουν αντιστοιχίσει ή θα αντιστοιχίσουν το δικό τους
+    if (chunkFd >= 0) close(chunkFd);
+
+    // Οι τερματισμοί των παιδιών παραδίδονται ως αναγνώσεις από το signalfd
+    int signalFd = signalfd(-1, &childMask, SFD_CLOEXEC);
+    if (signalFd == -1) {
+        std::perror("signalfd");
+        return 2;
     }
 
-    // Αναμένω όλα τα Splitter να τελειώσουν
-    Vector<Time> timesUSR1;
-    USRResult resultUSR1 = waitUSR(params.numOfSplitter, allpipeUSR1, "SplitterDone");
-    // Περιμένει να λάβει το μήνυμα "SplitterDone" από όλους τους splitters μέσω των pipes allpipeUSR1.
-
-    // Διαβάζει τις κορυφαίες λέξεις από τους builders
-    Vector<WordCount> vecTopK = readTopK(params.numOfBuilders);
-
-    // Αναμένω όλα τα Builders να τελειώσου
-    Vector<Time> timesUSR2;
-    USRResult resultUSR2 = waitUSR(params.numOfBuilders, allpipeUSR2, "BuilderDonee");
-    // Περιμένει να λάβει το μήνυμα "BuilderDonee" από όλους τους builders μέσω των pipes allpipeUSR2.
-
-    // Ταξινόμηση με βάση το count σε φθίνουσα σειρά
-    vector_sort(vecTopK, [](const WordCount& a, const WordCount& b) {
-        return a.count > b.count;  
-    });
-
-    // Γράψιμο των αποτελεσμάτων στο αρχείο
-    writeResultsToFile(params, vecTopK);
+    // Συλλογή χρόνων και αποτελεσμάτων με τη σειρά που ολοκληρώνονται οι splitters και οι builders
+    Vector<WordCount> vecTopK;
+    USRResult resultUSR1, resultUSR2;
+    bool childrenOk;
+    if (follow) {
+        // Ένας splitter που τερμάτισε δεν πρέπει να τερματίσει τη ρίζα με SIGPIPE στο pipe ελέγχου του
+        signal(SIGPIPE, SIG_IGN);
+        childrenOk = runFollow(params, allpipeUSR1, allpipeUSR2, allpipeControl, signalFd, inputFd, boundaries[params.numOfSplitter],
+                               sharedRings ? &ringMesh : nullptr, vecTopK, resultUSR1, resultUSR2);
+        close(inputFd);
+    } else {
+        childrenOk = runEventLoop(params, allpipeUSR1, allpipeUSR2, signalFd, sharedRings ? &ringMesh : nullptr, vecTopK, resultUSR1, resultUSR2);
+    }
+    close(signalFd);
 
+    // Γράψιμο των αποτελεσμάτων στο αρχείο (με --follow έχει ήδη γραφτεί με την τελευταία ανανέωση)
+    if (!follow) writeResultsToFile(params, params.outputFile, vecTopK);
 
-    // Η γονική διαδικασία περιμένει όλους τους συγγραφείς (splitters και builders) να ολοκληρωθούν
-    for (int i = 0; i < params.numOfSplitter + params.numOfBuilders; ++i) {
-        wait(NULL);     // Περιμένει την ολοκλήρωση όλων των child διεργασιών
+    // Εκτύπωση αποτελεσμάτων
+    printResults(params, vecTopK, resultUSR1, resultUSR2);
+    if (params.reportFormat[0] != '\0') {
+        writeReport(params, clockSeconds(CLOCK_MONOTONIC) - startTime, vecTopK, resultUSR1, resultUSR2);
     }
+    freeResults(vecTopK);
+    if (trace != nullptr) finishTrace(params, trace, traceFd);
 
-    // Εκτύπωση αποτελεσμάτων
-    printResults(vecTopK, params.topK, resultUSR1, resultUSR2);
-        
-    return 0;
+    return childrenOk ? 0 : 2;
 }
 
 Parameters parseArguments(int argc, char* argv[]) {
-    Parameters params = {"", "", "", 0, 0, 0};
+    Parameters params = {"", "", "", 0, 0, 0, "pread", 64 * 1024, false, 0, "auto", false, "fifo", 0, 0, 0, "", "", -1};
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
@@ -244,226 +484,1108 @@ Parameters parseArguments(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
             params.topK = std::atoi(argv[i + 1]);
             i++;
+        } else if (strcmp(argv[i], "--wire-hashes") == 0) {
+            params.wireHashes = true;
+        } else if (strcmp(argv[i], "--combine") == 0 && i + 1 < argc) {
+            params.combineBytes = std::strtoll(argv[i + 1], NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            params.batchSize = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "--tokenizer") == 0 && i + 1 < argc) {
+            strncpy(params.tokenizerKernel, argv[i + 1], sizeof(params.tokenizerKernel) - 1);
+            params.tokenizerKernel[sizeof(params.tokenizerKernel) - 1] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "--transport") == 0 && i + 1 < argc) {
+            strncpy(params.transport, argv[i + 1], sizeof(params.transport) - 1);
+            params.transport[sizeof(params.transport) - 1] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "--follow") == 0 && i + 1 < argc) {
+            params.followInterval = std::strtod(argv[i + 1], NULL);
+            i++;
+        } else if (strcmp(argv[i], "--approx") == 0 && i + 1 < argc) {
+            params.approxEpsilon = std::strtod(argv[i + 1], NULL);
+            i++;
+        } else if (strcmp(argv[i], "--mem-budget") == 0 && i + 1 < argc) {
+            params.memBudget = std::strtoll(argv[i + 1], NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+            strncpy(params.reportFormat, argv[i + 1], sizeof(params.reportFormat) - 1);
+            params.reportFormat[sizeof(params.reportFormat) - 1] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+            params.chunkBytes = std::strtoll(argv[i + 1], NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            strncpy(params.traceFile, argv[i + 1], 255);
+            params.traceFile[255] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            params.threads = true;
+        } else if (strcmp(argv[i], "--reader") == 0 && i + 1 < argc) {
+            strncpy(params.readerBackend, argv[i + 1], sizeof(params.readerBackend) - 1);
+            params.readerBackend[sizeof(params.readerBackend) - 1] = '\0';
+            i++;
         }
     }
 
     if (strlen(params.inputFile) == 0 || strlen(params.outputFile) == 0 || strlen(params.exclusionFile) == 0 ||
-        params.numOfSplitter <= 0 || params.numOfBuilders <= 0 || params.topK <= 0) {
-        std::cerr << "Usage: ./lexan -i inputfile -l numOfSplitter -m numOfBuilders -t TopPopular -e ExclusionList -o outfile" << std::endl;
+        params.numOfSplitter <= 0 || params.numOfBuilders <= 0 || params.topK <= 0 || !isReaderBackend(params.readerBackend) ||
+        params.batchSize < PIPE_BUF || params.combineBytes < 0 || !isTokenizerKernel(params.tokenizerKernel) ||
+        (strcmp(params.transport, "fifo") != 0 && strcmp(params.transport, "shm") != 0) ||
+        params.followInterval < 0 || (params.followInterval > 0 && params.threads) || params.approxEpsilon < 0 || params.approxEpsilon >= 1 ||
+        params.memBudget < 0 || (params.memBudget > 0 && params.approxEpsilon > 0) || params.chunkBytes < -1 ||
+        (params.reportFormat[0] != '\0' && strcmp(params.reportFormat, "json") != 0 && strcmp(params.reportFormat, "csv") != 0)) {
+        std::cerr << "Usage: ./lexan -i inputfile -l numOfSplitter -m numOfBuilders -t TopPopular -e ExclusionList -o outfile"
+                  << " [--reader mmap|pread|uring] [--batch bytes] [--wire-hashes] [--combine bytes]"
+                  << " [--tokenizer auto|scalar|sse2|avx2] [--threads] [--transport fifo|shm] [--follow seconds] [--approx epsilon] [--mem-budget bytes] [--chunk bytes] [--report json|csv] [--trace tracefile]" << std::endl;
         std::exit(1);
     }
 
+    // Με --follow οι εποχές μοιράζονται πάντα σταθερά. Αλλιώς, χωρίς --chunk, το μέγεθος προκύπτει
+    // από το fstat της εισόδου κατά τον διαχωρισμό της.
+    if (params.chunkBytes == -1 && params.followInterval > 0) params.chunkBytes = 0;
+
     return params;
 }
 
-int countLines(const char* filename) {
+bool partitionInput(const char* filename, int numOfParts, long long& chunkBytes, Vector<long long>& boundaries) {
     // Άνοιγμα του αρχείου εισόδου
     int file_fd = open(filename, O_RDONLY);
     if (file_fd == -1) {    // Έλεγχος αποτυχίας ανοίγματος
         std::perror("open input file");
-        return -1;
+        return false;
     }
 
-    // Μετατροπή του file descriptor σε FILE* για χρήση με fgets
-    FILE* file = fdopen(file_fd, "r");
-    if (file == NULL) {     // Έλεγχος αποτυχίας μετατροπής
-        std::perror("fdopen");
+    // Το μέγεθος προκύπτει από το fstat, χωρίς ανάγνωση του αρχείου
+    struct stat st;
+    if (fstat(file_fd, &st) == -1) {
+        std::perror("fstat");
         close(file_fd);
-        return -1;
+        return false;
+    }
+    long long size = static_cast<long long>(st.st_size);
+    if (chunkBytes == -1) chunkBytes = defaultChunkBytes(size, numOfParts);
+    if (chunkBytes > 0) {
+        // Τα όρια των τμημάτων τα βρίσκουν οι splitters όταν τα διεκδικούν
+        boundaries.clear();
+        boundaries.push_back(0);
+        boundaries.push_back(size);
+    } else {
+        partitionRange(file_fd, 0, size, numOfParts, boundaries);
     }
 
-    const size_t buffer_size = 1024;
-    char buffer[buffer_size];
+    close(file_fd);
+    return true;
+}
+
+long long defaultChunkBytes(long long inputSize, int numOfSplitter) {
+    const long long CHUNKS_PER_SPLITTER = 8;
+    const long long MIN_CHUNK = 64 * 1024;
+    const long long MAX_CHUNK = 4 * 1024 * 1024;
+
+    long long chunk = inputSize / (numOfSplitter * CHUNKS_PER_SPLITTER);
+    if (chunk < MIN_CHUNK) chunk = MIN_CHUNK;
+    if (chunk > MAX_CHUNK) chunk = MAX_CHUNK;
+    return chunk;
+}
+
+void partitionRange(int fd, long long start, long long end, int numOfParts, Vector<long long>& boundaries) {
+    // Ονομαστικά όρια σε ίσα διαστήματα, μετακινημένα στον επόμενο διαχωριστή
+    boundaries.clear();
+    boundaries.reserve(numOfParts + 1);
+    boundaries.push_back(start);
+    for (int i = 1; i < numOfParts; i++) {
+        long long nominal = start + (end - start) / numOfParts * i;
+        long long snapped = snapOffset(fd, nominal, end);
+        if (snapped < boundaries[i - 1]) snapped = boundaries[i - 1];
+        boundaries.push_back(snapped);
+    }
+    boundaries.push_back(end);
+}
+
+long long lastSeparatorEnd(int fd, long long start, long long fileSize) {
+    const size_t window_size = 64 * 1024;
+    char buffer[window_size];
 
-    int  line = 0;      // Μετρητής γραμμών
-    while (fgets(buffer, buffer_size, file) != NULL) {  // Ανάγνωση γραμμών
-        line++;
+    // Αναζήτηση από το τέλος προς την αρχή, ένα παράθυρο κάθε φορά
+    long long position = fileSize;
+    while (position > start) {
+        long long windowStart = position - static_cast<long long>(window_size) > start ? position - static_cast<long long>(window_size) : start;
+        ssize_t bytes_read = pread(fd, buffer, static_cast<size_t>(position - windowStart), windowStart);
+        if (bytes_read <= 0) break;
+
+        for (ssize_t i = bytes_read - 1; i >= 0; i--) {
+            if (buffer[i] == '\n') return windowStart + i + 1;
+        }
+        position = windowStart;
     }
+    return start;
+}
+
+int compileExclusionSet(const char* exclusionFile) {
+    ExclusionSet exclusionSet;
+    if (!exclusionSet.loadFile(exclusionFile)) return -1;
 
-    fclose(file);  // Κλείσιμο του αρχείου
-    return line;   // Επιστροφή του αριθμού γραμμών
+    // Ανώνυμο αρχείο στη μνήμη, χωρίς FD_CLOEXEC ώστε να περάσει στους splitters μέσω exec
+    int fd = memfd_create("laxen-exclusions", 0);
+    if (fd == -1) {
+        std::perror("memfd_create");
+        return -1;
+    }
+    if (!exclusionSet.writeImage(fd)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
 }
 
-const char* intToStr(int number) {
-    static char buffers[10][20];
+const char* intToStr(long long number) {
+    // Αρκετές θέσεις για όλα τα αριθμητικά ορίσματα μιας κλήσης execl
+    static char buffers[16][24];
     static int index = 0;
 
     char* str = buffers[index];
-    index = (index + 1) % 10; 
+    index = (index + 1) % 16;
 
-    sprintf(str, "%d", number);
+    sprintf(str, "%lld", number);
     return str;
 }
 
-USRResult waitUSR(int numOf, const List<PipeFD>& allpipeUSR, const char* acceptBuffer) {
-    USRResult result;
-    result.received = 0;       // Μετρητής ληφθέντων μηνυμάτων
-    // Προσαρμογή μεγέθους του Vector
-    for (int i = 0; i < numOf; ++i) {
-        Time t;
-        result.times.push_back(t); 
+// Κατάσταση ενός νήματος splitter
+struct SplitterThread {
+    int id;
+    const Parameters* params;
+    const ExclusionSet* exclusionSet;
+    const RingMesh* mesh;
+    long long startByte;
+    long long endByte;
+    ChunkQueue* chunks;     // Κοινή ουρά τμημάτων (nullptr = μόνο το [startByte, endByte))
+    ProcessStats stats;
+    TraceBuffer* trace;     // Φάσεις του νήματος (nullptr χωρίς --trace)
+    bool ok;
+};
+
+// Κατάσταση ενός νήματος builder
+struct BuilderThread {
+    int id;
+    const Parameters* params;
+    const RingMesh* mesh;
+    Vector<WordCount> results;  // Οι topK λέξεις του builder, ταξινομημένες (αντίγραφα)
+    ProcessStats stats;
+    TraceBuffer* trace;         // Φάσεις του νήματος (nullptr χωρίς --trace)
+    bool ok;
+};
+
+static void* splitterThreadMain(void* arg) {
+    SplitterThread& task = *static_cast<SplitterThread*>(arg);
+    const Parameters& params = *task.params;
+    if (task.trace != nullptr) task.trace->activate();
+    double t1 = clockSeconds(CLOCK_MONOTONIC);
+    double c1 = clockSeconds(CLOCK_THREAD_CPUTIME_ID);
+
+    // Μία έξοδος ανά builder, που γράφει στον δακτύλιο του ζεύγους
+    Vector<SpscRing*> rings;
+    Vector<BuilderOutput*> builderOutputs;
+    unsigned wireFlags = params.wireHashes ? WIRE_HASHES : 0;
+    for (int j = 0; j < params.numOfBuilders; j++) {
+        SpscRing* ring = new SpscRing(task.mesh->ring(task.id, j), task.mesh->doorbell(j));
+        rings.push_back(ring);
+        builderOutputs.push_back(new BuilderOutput(ring, params.batchSize, wireFlags));
     }
 
-    // Κλείνουμε τα write ends των pipes στον parent process
-    List<PipeFD>::ListNode* currentNode = allpipeUSR.getHead();
-    while (currentNode != nullptr) {
-        close(currentNode->data.fd[1]);     // Κλείσιμο του write end κάθε pipe
-        currentNode = currentNode->next;
+    SplitterOptions options = { params.inputFile, task.startByte, task.endByte, params.readerBackend, params.tokenizerKernel, params.combineBytes,
+                               task.chunks };
+    task.ok = runSplitter(options, *task.exclusionSet, builderOutputs, task.stats);
+    collectOutputStats(builderOutputs, task.stats);
+    for (size_t j = 0; j < builderOutputs.get_size(); j++) {
+        delete builderOutputs[j];
+        delete rings[j];
     }
 
-    // Δημιουργούμε έναν buffer για την αποθήκευση των μηνυμάτων που λαμβάνονται
-    const size_t buffer_size = 1024;
-    char buffer[buffer_size];
+    task.stats.realTime = clockSeconds(CLOCK_MONOTONIC) - t1;
+    task.stats.cpuTime = clockSeconds(CLOCK_THREAD_CPUTIME_ID) - c1;
+    collectUsage(task.stats, RUSAGE_THREAD);
+    currentTrace = nullptr;
+    return NULL;
+}
 
-    // Διατρέχουμε τη λίστα των pipes για ανάγνωση
-    currentNode = allpipeUSR.getHead();
-    while (currentNode != nullptr && result.received < numOf) {
-        int fd = currentNode->data.fd[0];   // Διαβάζουμε από το read end του pipe
-        ssize_t bytesRead = read(fd, buffer, buffer_size - 1);
-        if (bytesRead > 0) {
-            buffer[bytesRead] = '\0'; // Τερματίζουμε τη συμβολοσειρά
-
-            // Έλεγχος αν το μήνυμα ξεκινάει με το acceptBuffer
-            if (strncmp(buffer, acceptBuffer, strlen(acceptBuffer)) == 0) {
-                int id;
-                double real_time, cpu_time;
-
-                // Εξαγωγή των `id`, `real_time`, και `cpu_time` τιμών από τη συμβολοσειρά
-                int res = sscanf(buffer + strlen(acceptBuffer), "-%d-%lf-%lf", &id, &real_time, &cpu_time);
-                if (res == 3) { // Έλεγχος επιτυχίας
-                    // Αποθήκευση στο vector στην κατάλληλη θέση
-                    if (id >= 0 && static_cast<size_t>(id) < result.times.get_size()) {
-                        result.times[id].real_time = real_time;
-                        result.times[id].cpu_time = cpu_time;
-                    } else {
-                        std::cerr << "Invalid Splitter ID: " << id << std::endl;
-                    }
-                    result.received++;
+// Καταμέτρηση των δακτυλίων ενός νήματος builder στα counts και αντιγραφή των topK λέξεων,
+// αφού η μνήμη των counts αποδεσμεύεται με το τέλος του νήματος
+template <typename Counts>
+static void countThreadTopK(BuilderThread& task, Vector<SpscRing*>& rings, Counts& counts) {
+    task.ok = countFromRings(rings, *task.mesh->doorbell(task.id), counts, nullptr, task.stats);
+    if (!task.ok) return;
+    task.stats.distinctWords = static_cast<long long>(counts.get_size());
+    task.stats.tableBytes = static_cast<long long>(counts.memoryUsage());
+
+    TraceSpan span("select topK");
+    Vector<RankedWord> wordVector = selectTopK(counts, task.params->topK);
+    task.results.reserve(wordVector.get_size());
+    for (size_t i = 0; i < wordVector.get_size(); i++) {
+        WordCount wc;
+        wc.word = new char[wordVector[i].length + 1];
+        memcpy(wc.word, wordVector[i].word, wordVector[i].length);
+        wc.word[wordVector[i].length] = '\0';
+        wc.count = wordVector[i].count;
+        wc.error = wordVector[i].error;
+        task.results.push_back(wc);
+    }
+}
+
+static void* builderThreadMain(void* arg) {
+    BuilderThread& task = *static_cast<BuilderThread*>(arg);
+    const Parameters& params = *task.params;
+    if (task.trace != nullptr) task.trace->activate();
+    double t1 = clockSeconds(CLOCK_MONOTONIC);
+    double c1 = clockSeconds(CLOCK_THREAD_CPUTIME_ID);
+
+    // Ένας δακτύλιος από κάθε splitter
+    Vector<SpscRing*> rings;
+    for (int i = 0; i < params.numOfSplitter; i++) {
+        rings.push_back(new SpscRing(task.mesh->ring(i, task.id), task.mesh->doorbell(task.id)));
+    }
+
+    if (params.approxEpsilon > 0) {
+        SpaceSaving sketch(SpaceSaving::capacityFor(params.approxEpsilon, params.topK));
+        countThreadTopK(task, rings, sketch);
+    } else if (params.memBudget > 0) {
+        SpillingCounts counts(static_cast<size_t>(params.memBudget), false);
+        countThreadTopK(task, rings, counts);
+        if (!counts.ok()) task.ok = false;
+    } else {
+        WordMap wordMap;
+        countThreadTopK(task, rings, wordMap);
+    }
+    for (size_t i = 0; i < rings.get_size(); i++) delete rings[i];
+
+    task.stats.realTime = clockSeconds(CLOCK_MONOTONIC) - t1;
+    task.stats.cpuTime = clockSeconds(CLOCK_THREAD_CPUTIME_ID) - c1;
+    collectUsage(task.stats, RUSAGE_THREAD);
+    currentTrace = nullptr;
+    return NULL;
+}
+
+// Σύγκριση για το σωρό των λιστών των builders: στην κορυφή η λίστα με την καλύτερη τρέχουσα λέξη
+struct ResultListOrder {
+    Vector<WordCount>* const* lists;
+    size_t* positions;
+    bool operator()(int a, int b) const {
+        return ranksBefore((*lists[a])[positions[a]], (*lists[b])[positions[b]]);
+    }
+};
+
+void mergeResults(Vector<WordCount>* const* lists, int numOfLists, size_t topK, Vector<WordCount>& results) {
+    size_t* positions = new size_t[numOfLists];
+    Heap<int, ResultListOrder> heap(ResultListOrder{ lists, positions });
+    for (int j = 0; j < numOfLists; j++) {
+        positions[j] = 0;
+        if (lists[j]->get_size() > 0) heap.push(j);
+    }
+    while (!heap.empty() && results.get_size() < topK) {
+        int j = heap.top();
+        Vector<WordCount>& list = *lists[j];
+        results.push_back(list[positions[j]]);
+        list[positions[j]].word = nullptr;   // Η λέξη περνά στα αποτελέσματα
+        if (++positions[j] < list.get_size()) {
+            heap.replaceTop(j);
+        } else {
+            heap.pop();
+        }
+    }
+    delete[] positions;
+}
+
+// Trace ενός νήματος με ετικέτα "<role> <id>", μέσα στη διεργασία της ρίζας
+static TraceBuffer* createThreadTrace(const char* role, int id) {
+    char label[32];
+    snprintf(label, sizeof(label), "%s %d", role, id);
+    return new TraceBuffer(label, false);
+}
+
+bool runThreads(Parameters& params, int traceFd, Vector<WordCount>& vecTopK, USRResult& resultUSR1, USRResult& resultUSR2) {
+    // Το σύνολο εξαιρέσεων φτιάχνεται μία φορά και διαβάζεται από όλους τους splitters
+    ExclusionSet exclusionSet;
+    TraceSpan exclusionSpan("load exclusion set");
+    exclusionSet.loadFile(params.exclusionFile);
+    exclusionSpan.end();
+
+    // Διαχωρισμός του αρχείου σε τμήματα bytes, ένα για κάθε splitter
+    TraceSpan partitionSpan("partition input");
+    Vector<long long> boundaries;
+    if (!partitionInput(params.inputFile, params.numOfSplitter, params.chunkBytes, boundaries)) {
+        std::cerr << "Error: Could not partition input file." << std::endl;
+        std::exit(1);
+    }
+    partitionSpan.end();
+
+    // Με --chunk τα νήματα διεκδικούν τμήματα από μια ουρά σε ιδιωτική μνήμη της διεργασίας
+    ChunkQueue chunkQueue;
+    if (params.chunkBytes > 0 && !chunkQueue.create(boundaries[0], boundaries[1], params.chunkBytes, -1)) std::exit(2);
+
+    // Ένας δακτύλιος ανά ζεύγος splitter -> builder σε ιδιωτική μνήμη της διεργασίας
+    RingMesh mesh;
+    if (!mesh.create(params.numOfSplitter, params.numOfBuilders, RingMesh::capacityFor(params.batchSize), -1)) std::exit(2);
+
+    // Εκκίνηση πρώτα των builders και μετά των splitters
+    BuilderThread* builders = new BuilderThread[params.numOfBuilders];
+    SplitterThread* splitters = new SplitterThread[params.numOfSplitter];
+    pthread_t* builderIds = new pthread_t[params.numOfBuilders];
+    pthread_t* splitterIds = new pthread_t[params.numOfSplitter];
+    for (int j = 0; j < params.numOfBuilders; j++) {
+        builders[j].id = j;
+        builders[j].params = &params;
+        builders[j].mesh = &mesh;
+        builders[j].trace = traceFd >= 0 ? createThreadTrace("builder", j) : nullptr;
+        builders[j].ok = false;
+        int err = pthread_create(&builderIds[j], NULL, builderThreadMain, &builders[j]);
+        if (err != 0) {
+            std::cerr << "pthread_create: " << strerror(err) << std::endl;
+            std::exit(3);
+        }
+    }
+    for (int i = 0; i < params.numOfSplitter; i++) {
+        splitters[i].id = i;
+        splitters[i].params = &params;
+        splitters[i].exclusionSet = &exclusionSet;
+        splitters[i].mesh = &mesh;
+        int part = params.chunkBytes > 0 ? 0 : i;   // Με --chunk όλοι παίρνουν όλη την είσοδο
+        splitters[i].startByte = boundaries[part];
+        splitters[i].endByte = boundaries[part + 1];
+        splitters[i].chunks = params.chunkBytes > 0 ? &chunkQueue : nullptr;
+        splitters[i].trace = traceFd >= 0 ? createThreadTrace("splitter", i) : nullptr;
+        splitters[i].ok = false;
+        int err = pthread_create(&splitterIds[i], NULL, splitterThreadMain, &splitters[i]);
+        if (err != 0) {
+            std::cerr << "pthread_create: " << strerror(err) << std::endl;
+            std::exit(3);
+        }
+    }
+
+    // Συλλογή των χρόνων με τον ίδιο τρόπο όπως τα μηνύματα ολοκλήρωσης των διεργασιών
+    TraceSpan waitSpan("wait");
+    bool threadsOk = true;
+    resultUSR1.received = 0;
+    resultUSR2.received = 0;
+    for (int i = 0; i < params.numOfSplitter; i++) {
+        pthread_join(splitterIds[i], NULL);
+        resultUSR1.stats.push_back(splitters[i].stats);
+        if (splitters[i].ok) {
+            resultUSR1.received++;
+        } else {
+            std::cerr << "Splitter thread " << i << " failed" << std::endl;
+            threadsOk = false;
+        }
+    }
+    for (int j = 0; j < params.numOfBuilders; j++) {
+        pthread_join(builderIds[j], NULL);
+        resultUSR2.stats.push_back(builders[j].stats);
+        if (builders[j].ok) {
+            resultUSR2.received++;
+        } else {
+            std::cerr << "Builder thread " << j << " failed" << std::endl;
+            threadsOk = false;
+        }
+    }
+
+    waitSpan.end();
+
+    // Οι φάσεις των νημάτων προστίθενται στο αρχείο trace πριν από αυτές της ρίζας
+    for (int i = 0; traceFd >= 0 && i < params.numOfSplitter; i++) {
+        splitters[i].trace->writeTo(traceFd, false);
+        delete splitters[i].trace;
+    }
+    for (int j = 0; traceFd >= 0 && j < params.numOfBuilders; j++) {
+        builders[j].trace->writeTo(traceFd, false);
+        delete builders[j].trace;
+    }
+
+    // Συγχώνευση των ταξινομημένων λιστών των builders μέχρι topK λέξεις
+    TraceSpan mergeSpan("merge results");
+    Vector<WordCount>** lists = new Vector<WordCount>*[params.numOfBuilders];
+    for (int j = 0; j < params.numOfBuilders; j++) lists[j] = &builders[j].results;
+    mergeResults(lists, params.numOfBuilders, static_cast<size_t>(params.topK), vecTopK);
+    // Λέξεις που δεν χρειάστηκαν
+    for (int j = 0; j < params.numOfBuilders; j++) freeResults(builders[j].results);
+    mergeSpan.end();
+
+    delete[] lists;
+    delete[] splitterIds;
+    delete[] builderIds;
+    delete[] splitters;
+    delete[] builders;
+    return threadsOk;
+}
+
+// Είδη πηγών του epoll της ρίζας: αποθηκεύονται στα υψηλά 32 bits του data.u64
+// και ο αριθμός του splitter/builder στα χαμηλά
+enum EventSource {
+    SOURCE_SPLITTER_DONE,
+    SOURCE_BUILDER_DONE,
+    SOURCE_BUILDER_STREAM,
+    SOURCE_CHILD,
+    SOURCE_INPUT,           // Αλλαγές του αρχείου εισόδου (--follow)
+    SOURCE_TIMER            // Διάστημα ανανέωσης (--follow)
+};
+
+// Καταχώριση ενός fd στο epoll για ανάγνωση
+static bool watchFd(int epollFd, int fd, EventSource source, int index) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.u64 = (static_cast<uint64_t>(source) << 32) | static_cast<uint32_t>(index);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        std::perror("epoll_ctl");
+        return false;
+    }
+    return true;
+}
+
+// Σύγκριση για το σωρό των ροών: στην κορυφή η ροή με την καλύτερη κεφαλή
+struct StreamOrder {
+    BuilderStream* streams;
+    bool operator()(int a, int b) const { return ranksBefore(streams[a].head, streams[b].head); }
+};
+
+// Κατάσταση της σταδιακής συγχώνευσης των ροών των builders
+struct Merge {
+    BuilderStream* streams;
+    Heap<int, StreamOrder> heap;    // Ροές με διαθέσιμη κεφαλή
+    int waitingCount;               // Ροές που δεν έχουν τελειώσει αλλά δεν έχουν ακόμα κεφαλή
+    size_t topK;
+    Vector<WordCount>& results;
+
+    Merge(BuilderStream* streams, int numOfStreams, size_t topK, Vector<WordCount>& results)
+        : streams(streams), heap(StreamOrder{ streams }), waitingCount(numOfStreams), topK(topK), results(results) {}
+
+    bool complete() const { return results.get_size() >= topK || (waitingCount == 0 && heap.empty()); }
+};
+
+// Εξαγωγή λέξεων όσο όλες οι ροές που δεν έχουν τελειώσει έχουν διαθέσιμη κεφαλή.
+// Μια λέξη είναι οριστική μόνο όταν έχει συγκριθεί με την κεφαλή κάθε ροής.
+static void advanceMerge(Merge& merge) {
+    while (merge.waitingCount == 0 && !merge.heap.empty() && merge.results.get_size() < merge.topK) {
+        int i = merge.heap.top();
+        BuilderStream& stream = merge.streams[i];
+
+        // Η κεφαλή περνά στα αποτελέσματα μαζί με τη μνήμη της λέξης
+        merge.results.push_back(stream.head);
+        stream.head.word = nullptr;
+
+        HeadStatus status = decodeHead(stream);
+        if (status == HEAD_READY) {
+            merge.heap.replaceTop(i);
+        } else {
+            merge.heap.pop();
+            if (status == HEAD_NEED_DATA) {
+                stream.waiting = true;
+                merge.waitingCount++;
+            }
+        }
+    }
+}
+
+// Νέα δεδομένα ή EOF σε μια ροή: αν η συγχώνευση περίμενε αυτή τη ροή, συνεχίζει
+static void resumeMerge(Merge& merge, int i) {
+    BuilderStream& stream = merge.streams[i];
+    if (!stream.waiting) return;
+
+    HeadStatus status = decodeHead(stream);
+    if (status == HEAD_NEED_DATA) return;
+    stream.waiting = false;
+    merge.waitingCount--;
+    if (status == HEAD_READY) merge.heap.push(i);
+    advanceMerge(merge);
+}
+
+// Μία ανάγνωση από τη ροή ενός builder και συνέχεια της συγχώνευσης. Επιστρέφει false αν
+// δεν υπήρχαν διαθέσιμα δεδομένα. Στο EOF το fd κλείνει και η ροή σημειώνεται ως eof.
+static bool readBuilderStream(int epollFd, Merge& merge, int index) {
+    BuilderStream& stream = merge.streams[index];
+    ssize_t bytes_read;
+    if (merge.complete()) {
+        // Τα υπόλοιπα δεδομένα διαβάζονται χωρίς ανάλυση, ώστε ο builder να μη μπλοκάρει στην εγγραφή
+        char buffer[4096];
+        bytes_read = read(stream.fd, buffer, sizeof(buffer));
+    } else {
+        bytes_read = stream.reader.readFrom(stream.fd);
+    }
+    if (bytes_read == -1) {
+        if (errno == EAGAIN || errno == EINTR) return false;
+        std::perror("read");
+        std::exit(EXIT_FAILURE);
+    }
+    if (bytes_read == 0) {      // EOF: ο builder έκλεισε το FIFO
+        stream.eof = true;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, stream.fd, NULL);
+        close(stream.fd);
+    }
+    if (!merge.complete()) resumeMerge(merge, index);
+    return true;
+}
+
+bool runEventLoop(const Parameters& params, const List<PipeFD>& allpipeUSR1, const List<PipeFD>& allpipeUSR2, int signalFd,
+                  RingMesh* ringMesh, Vector<WordCount>& vecTopK, USRResult& resultUSR1, USRResult& resultUSR2) {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        std::perror("epoll_create1");
+        std::exit(2);
+    }
+
+    // Αρχικοποίηση των αποτελεσμάτων με μία θέση ανά splitter και builder
+    ProcessStats zero;
+    resultUSR1.received = 0;
+    resultUSR2.received = 0;
+    for (int i = 0; i < params.numOfSplitter; ++i) resultUSR1.stats.push_back(zero);
+    for (int i = 0; i < params.numOfBuilders; ++i) resultUSR2.stats.push_back(zero);
+
+    // Pipes ολοκλήρωσης, με τη σειρά των αναγνωριστικών
+    int openSources = 0;
+    List<PipeFD>::ListNode* currentNode = allpipeUSR1.getHead();
+    for (int i = 0; currentNode != nullptr; i++, currentNode = currentNode->next) {
+        if (!watchFd(epollFd, currentNode->data.fd[0], SOURCE_SPLITTER_DONE, i)) std::exit(2);
+        openSources++;
+    }
+    currentNode = allpipeUSR2.getHead();
+    for (int i = 0; currentNode != nullptr; i++, currentNode = currentNode->next) {
+        if (!watchFd(epollFd, currentNode->data.fd[0], SOURCE_BUILDER_DONE, i)) std::exit(2);
+        openSources++;
+    }
+
+    // Ροές αποτελεσμάτων. Το άνοιγμα χωρίς μπλοκάρισμα επιτυγχάνει πριν ανοίξει ο builder το FIFO.
+    // Ο πυρήνας δεν αναφέρει EPOLLHUP σε FIFO που δεν έχει αποκτήσει ακόμα writer, οπότε ένα read
+    // που επιστρέφει 0 μετά από γεγονός σημαίνει πραγματικό τέλος της ροής.
+    BuilderStream* streams = new BuilderStream[params.numOfBuilders];
+    for (int jj = 0; jj < params.numOfBuilders; jj++) {
+        char fifo_path[50];
+        sprintf(fifo_path, "fifo_builder%d_laxen", jj);     // Δημιουργία ονόματος του named pipe
+
+        int fd = open(fifo_path, O_RDONLY | O_NONBLOCK);
+        if (fd == -1) {     // Έλεγχος αποτυχίας ανοίγματος
+            std::perror("open");
+            std::exit(EXIT_FAILURE);
+        }
+        streams[jj].fd = fd;
+        streams[jj].eof = false;
+        streams[jj].waiting = true;
+        streams[jj].head.word = nullptr;
+        if (!watchFd(epollFd, fd, SOURCE_BUILDER_STREAM, jj)) std::exit(2);
+        openSources++;
+    }
+    Merge merge(streams, params.numOfBuilders, static_cast<size_t>(params.topK), vecTopK);
+
+    // Τερματισμοί παιδιών. Τερματισμοί πριν από τη δημιουργία του signalfd έχουν μείνει εκκρεμείς
+    // λόγω της μάσκας και αναφέρονται κανονικά.
+    int children = params.numOfSplitter + params.numOfBuilders;
+    bool childrenOk = true;
+    if (!watchFd(epollFd, signalFd, SOURCE_CHILD, 0)) std::exit(2);
+    openSources++;
+
+    const int maxEvents = 32;
+    struct epoll_event events[maxEvents];
+    while (openSources > 0) {
+        int ready;
+        {
+            TraceSpan span("wait");
+            ready = epoll_wait(epollFd, events, maxEvents, -1);
+        }
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            std::perror("epoll_wait");
+            std::exit(2);
+        }
+
+        for (int e = 0; e < ready; e++) {
+            EventSource source = static_cast<EventSource>(events[e].data.u64 >> 32);
+            int index = static_cast<int>(events[e].data.u64 & 0xffffffffu);
+
+            if (source == SOURCE_SPLITTER_DONE || source == SOURCE_BUILDER_DONE) {
+                // Το μήνυμα είναι μικρότερο από PIPE_BUF και φτάνει με μία ανάγνωση
+                const List<PipeFD>& pipes = source == SOURCE_SPLITTER_DONE ? allpipeUSR1 : allpipeUSR2;
+                currentNode = pipes.getHead();
+                for (int i = 0; i < index; i++) currentNode = currentNode->next;
+                int fd = currentNode->data.fd[0];
+                if (source == SOURCE_SPLITTER_DONE) {
+                    readDoneMessage(fd, "SplitterDone", resultUSR1);
                 } else {
-                    std::cerr << "Failed to parse message: " << buffer << std::endl;
+                    readDoneMessage(fd, "BuilderDonee", resultUSR2);
+                }
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, NULL);
+                close(fd);      // Κλείσιμο του read end του pipe
+                openSources--;
+            } else if (source == SOURCE_BUILDER_STREAM) {
+                if (streams[index].eof) continue;   // Η ροή έκλεισε ήδη σε προηγούμενο γεγονός του ίδιου γύρου
+                TraceSpan span("merge results");
+                if (readBuilderStream(epollFd, merge, index) && streams[index].eof) {
+                    streams[index].fd = -1;
+                    openSources--;
+                }
+            } else {
+                // Ένα σήμα μπορεί να αντιστοιχεί σε περισσότερους τερματισμούς: συλλογή όλων με WNOHANG
+                struct signalfd_siginfo info[8];
+                if (read(signalFd, info, sizeof(info)) == -1 && errno != EAGAIN) {
+                    std::perror("read signalfd");
+                }
+                int status;
+                pid_t child;
+                while (children > 0 && (child = waitpid(-1, &status, WNOHANG)) > 0) {
+                    children--;
+                    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                        std::cerr << "Child process " << child << " terminated abnormally (status " << status << ")" << std::endl;
+                        if (childrenOk && ringMesh != nullptr) ringMesh->abortAll();
+                        childrenOk = false;
+                    }
+                }
+                if (children == 0) {
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, signalFd, NULL);
+                    openSources--;
+
+                    // Ένας builder που τερμάτισε χωρίς να ανοίξει το FIFO του δεν προκαλεί ποτέ γεγονός.
+                    // Χωρίς writers η ανάγνωση δίνει αμέσως όσα δεδομένα έμειναν και μετά EOF.
+                    for (int jj = 0; jj < params.numOfBuilders; jj++) {
+                        while (!streams[jj].eof && readBuilderStream(epollFd, merge, jj)) {}
+                        if (streams[jj].eof && streams[jj].fd != -1) {
+                            streams[jj].fd = -1;
+                            openSources--;
+                        }
+                    }
                 }
             }
-        } else if (bytesRead == 0) {
-            perror("Pipe closed without receiving ");
-        } else {        // Σφάλμα κατά την ανάγνωση
-            perror("read failed");
         }
-        close(fd);      // Κλείσιμο του read end του pipe
-        currentNode = currentNode->next;
     }
+    close(epollFd);
 
+    // Κεφαλές που δεν χρειάστηκαν
+    for (int i = 0; i < params.numOfBuilders; i++) delete[] streams[i].head.word;
+    delete[] streams;
 
     // Έλεγχος αν τα αναμενόμενα μηνύματα λήφθηκαν
-    if (result.received != numOf) {
-        std::cerr << "Expected " << numOf << " " << acceptBuffer << " messages, but received " << result.received << std::endl;
+    if (resultUSR1.received != params.numOfSplitter) {
+        std::cerr << "Expected " << params.numOfSplitter << " SplitterDone messages, but received " << resultUSR1.received << std::endl;
     }
+    if (resultUSR2.received != params.numOfBuilders) {
+        std::cerr << "Expected " << params.numOfBuilders << " BuilderDonee messages, but received " << resultUSR2.received << std::endl;
+    }
+    return childrenOk;
+}
 
-    return result;
+// Ροή στιγμιοτύπων ενός builder με --follow
+struct FollowStream {
+    int fd;                     // File descriptor του named pipe (-1 μετά το EOF)
+    WireReader reader;
+    Vector<WordCount> segment;  // Οι topK λέξεις του builder στο τρέχον στιγμιότυπο (αντίγραφα)
+    uint64_t epoch;             // Εποχή της τελευταίας σήμανσης
+    bool complete;              // Το στιγμιότυπο ολοκληρώθηκε με σήμανση εποχής ή με EOF
+    bool atEnd;                 // Το στιγμιότυπο ολοκληρώθηκε με EOF (τελικά αποτελέσματα)
+    bool finished;              // Το τελικό στιγμιότυπο έχει δημοσιευτεί
+    bool eof;
+};
+
+// Αποκωδικοποίηση του στιγμιοτύπου μέχρι τη σήμανση εποχής ή το EOF. Ό,τι ακολουθεί
+// μένει στον reader μέχρι να δημοσιευτεί το τρέχον στιγμιότυπο.
+static void decodeSegment(FollowStream& stream) {
+    WireRecord record;
+    while (!stream.complete) {
+        WireStatus status = stream.reader.next(record);
+        if (status == WIRE_ERROR) {
+            std::cerr << "Error: Invalid data from builder." << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        if (status == WIRE_MARK) {
+            stream.epoch = record.count;
+            stream.complete = true;
+        } else if (status == WIRE_RECORD) {
+            WordCount wc;
+            wc.word = new char[record.length + 1];
+            memcpy(wc.word, record.word, record.length);
+            wc.word[record.length] = '\0';
+            wc.count = static_cast<long long>(record.count);
+            wc.error = static_cast<long long>(record.error);
+            stream.segment.push_back(wc);
+        } else {
+            if (!stream.eof) return;
+            if (!stream.reader.empty()) {
+                std::cerr << "Error: Truncated data from builder." << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+            stream.complete = true;
+            stream.atEnd = true;
+        }
+    }
+}
+
+// Μία ανάγνωση από τη ροή ενός builder. Επιστρέφει false αν δεν υπήρχαν διαθέσιμα δεδομένα.
+static bool readFollowStream(int epollFd, FollowStream& stream) {
+    ssize_t bytes_read = stream.reader.readFrom(stream.fd);
+    if (bytes_read == -1) {
+        if (errno == EAGAIN || errno == EINTR) return false;
+        std::perror("read");
+        std::exit(EXIT_FAILURE);
+    }
+    if (bytes_read == 0) {      // EOF: ο builder έκλεισε το FIFO
+        stream.eof = true;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, stream.fd, NULL);
+        close(stream.fd);
+        stream.fd = -1;
+    }
+    decodeSegment(stream);
+    return true;
+}
+
+// Δημοσίευση των στιγμιοτύπων αν έχουν ολοκληρωθεί σε όλους τους builders: συγχώνευση στο vecTopK
+// και αντικατάσταση του αρχείου εξόδου μέσω μετονομασίας, ώστε οι αναγνώστες του να μη βλέπουν
+// ποτέ μισό αρχείο. Επιστρέφει false αν κάποιο στιγμιότυπο δεν έχει φτάσει ακόμα.
+static bool publishSegments(const Parameters& params, FollowStream* streams, long long dispatchedEnd, Vector<WordCount>& vecTopK) {
+    bool any = false;
+    for (int j = 0; j < params.numOfBuilders; j++) {
+        if (streams[j].finished) continue;
+        if (!streams[j].complete) return false;
+        any = true;
+    }
+    if (!any) return false;
+
+    TraceSpan span("publish");
+    freeResults(vecTopK);
+    vecTopK.clear();
+    Vector<WordCount>** lists = new Vector<WordCount>*[params.numOfBuilders];
+    for (int j = 0; j < params.numOfBuilders; j++) lists[j] = &streams[j].segment;
+    mergeResults(lists, params.numOfBuilders, static_cast<size_t>(params.topK), vecTopK);
+    delete[] lists;
+
+    char tmpPath[300];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", params.outputFile);
+    writeResultsToFile(params, tmpPath, vecTopK);
+    if (rename(tmpPath, params.outputFile) == -1) std::perror("rename");
+
+    // Το επόμενο στιγμιότυπο κάθε builder μπορεί να βρίσκεται ήδη στον reader
+    uint64_t epoch = 0;
+    bool final = false;
+    for (int j = 0; j < params.numOfBuilders; j++) {
+        FollowStream& stream = streams[j];
+        if (stream.finished) continue;
+        if (stream.epoch > epoch) epoch = stream.epoch;
+        if (stream.atEnd) final = true;
+        freeResults(stream.segment);
+        stream.segment.clear();
+        if (stream.atEnd) {
+            stream.finished = true;
+        } else {
+            stream.complete = false;
+            decodeSegment(stream);
+        }
+    }
+    if (!final) {
+        std::cout << "Epoch " << epoch << ": " << dispatchedEnd << " bytes, top-" << params.topK << " written to " << params.outputFile << std::endl;
+    }
+    return true;
 }
 
-Vector<WordCount> readTopK(int numOfBuilders) {
-    // Vector για αποθήκευση των file descriptors από τα pipes των builders
-    Vector<int> allpipeTOPK;    
-    for (int jj = 0; jj < numOfBuilders; jj++) { 
+// Τέλος της παρακολούθησης: το κλείσιμο των pipes ελέγχου τερματίζει τους splitters μετά το τρέχον τμήμα
+static void stopFollowing(List<PipeFD>& allpipeControl, int epollFd, int& inotifyFd, int& timerFd, int& openSources) {
+    for (List<PipeFD>::ListNode* node = allpipeControl.getHead(); node != nullptr; node = node->next) {
+        if (node->data.fd[1] != -1) close(node->data.fd[1]);
+        node->data.fd[1] = -1;
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, inotifyFd, NULL);
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, timerFd, NULL);
+    close(inotifyFd);
+    close(timerFd);
+    inotifyFd = -1;
+    timerFd = -1;
+    openSources -= 2;
+}
+
+bool runFollow(const Parameters& params, const List<PipeFD>& allpipeUSR1, const List<PipeFD>& allpipeUSR2, List<PipeFD>& allpipeControl,
+               int signalFd, int inputFd, long long dispatchedEnd, RingMesh* ringMesh,
+               Vector<WordCount>& vecTopK, USRResult& resultUSR1, USRResult& resultUSR2) {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        std::perror("epoll_create1");
+        std::exit(2);
+    }
+
+    ProcessStats zero;
+    resultUSR1.received = 0;
+    resultUSR2.received = 0;
+    for (int i = 0; i < params.numOfSplitter; ++i) resultUSR1.stats.push_back(zero);
+    for (int i = 0; i < params.numOfBuilders; ++i) resultUSR2.stats.push_back(zero);
+
+    // Pipes ολοκλήρωσης, που γράφονται μόνο μετά το τέλος της παρακολούθησης
+    int openSources = 0;
+    List<PipeFD>::ListNode* currentNode = allpipeUSR1.getHead();
+    for (int i = 0; currentNode != nullptr; i++, currentNode = currentNode->next) {
+        if (!watchFd(epollFd, currentNode->data.fd[0], SOURCE_SPLITTER_DONE, i)) std::exit(2);
+        openSources++;
+    }
+    currentNode = allpipeUSR2.getHead();
+    for (int i = 0; currentNode != nullptr; i++, currentNode = currentNode->next) {
+        if (!watchFd(epollFd, currentNode->data.fd[0], SOURCE_BUILDER_DONE, i)) std::exit(2);
+        openSources++;
+    }
+
+    // Ροές στιγμιοτύπων των builders
+    FollowStream* streams = new FollowStream[params.numOfBuilders];
+    for (int jj = 0; jj < params.numOfBuilders; jj++) {
         char fifo_path[50];
-        sprintf(fifo_path, "fifo_builder%d_laxen", jj);     // Δημιουργία ονόματος του named pipe
+        sprintf(fifo_path, "fifo_builder%d_laxen", jj);
 
-        // Άνοιγμα του named pipe για ανάγνωση 
-        int fd = open(fifo_path, O_RDONLY);
-        if (fd == -1) {     // Έλεγχος αποτυχίας ανοίγματος
+        int fd = open(fifo_path, O_RDONLY | O_NONBLOCK);
+        if (fd == -1) {
             std::perror("open");
-            std::exit(EXIT_FAILURE);  
+            std::exit(EXIT_FAILURE);
         }
-        allpipeTOPK.push_back(fd);      // Αποθήκευση του file descriptor
+        FollowStream& stream = streams[jj];
+        stream.fd = fd;
+        stream.epoch = 0;
+        stream.complete = false;
+        stream.atEnd = false;
+        stream.finished = false;
+        stream.eof = false;
+        if (!watchFd(epollFd, fd, SOURCE_BUILDER_STREAM, jj)) std::exit(2);
+        openSources++;
     }
 
-    // Vector για αποθήκευση των αποτελεσμάτων (WordCount)
-    Vector<WordCount> wordCounts;
+    int children = params.numOfSplitter + params.numOfBuilders;
+    bool childrenOk = true;
+    if (!watchFd(epollFd, signalFd, SOURCE_CHILD, 0)) std::exit(2);
+    openSources++;
 
-    const size_t buffer_size = 1024;
-    char buffer[buffer_size];
+    // Αλλαγές του αρχείου εισόδου. Μια μετονομασία ή διαγραφή (π.χ. rotation) τερματίζει την παρακολούθηση.
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd == -1 || inotify_add_watch(inotifyFd, params.inputFile, IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF) == -1) {
+        std::perror("inotify");
+        std::exit(2);
+    }
+    if (!watchFd(epollFd, inotifyFd, SOURCE_INPUT, 0)) std::exit(2);
+    openSources++;
+
+    // Περιοδικό χρονόμετρο: οι αλλαγές συγκεντρώνονται και στέλνονται το πολύ μία φορά ανά διάστημα
+    int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct itimerspec interval;
+    interval.it_interval.tv_sec = static_cast<time_t>(params.followInterval);
+    interval.it_interval.tv_nsec = static_cast<long>((params.followInterval - static_cast<double>(interval.it_interval.tv_sec)) * 1e9);
+    if (interval.it_interval.tv_sec == 0 && interval.it_interval.tv_nsec == 0) interval.it_interval.tv_nsec = 1;
+    interval.it_value = interval.it_interval;
+    if (timerFd == -1 || timerfd_settime(timerFd, 0, &interval, NULL) == -1) {
+        std::perror("timerfd");
+        std::exit(2);
+    }
+    if (!watchFd(epollFd, timerFd, SOURCE_TIMER, 0)) std::exit(2);
+    openSources++;
+
+    bool stopping = false;
+    bool grown = false;         // Το αρχείο άλλαξε μετά την τελευταία αποστολή
+    bool inFlight = true;       // Η αρχική εποχή βρίσκεται σε επεξεργασία
+    Vector<long long> boundaries;
+
+    const int maxEvents = 32;
+    struct epoll_event events[maxEvents];
+    while (openSources > 0) {
+        int ready;
+        {
+            TraceSpan span("wait");
+            ready = epoll_wait(epollFd, events, maxEvents, -1);
+        }
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            std::perror("epoll_wait");
+            std::exit(2);
+        }
 
-    // Vector για παρακολούθηση των ενεργών FIFOs
-    Vector<bool> activeFds;
-    for (int i = 0; i < numOfBuilders; i++) activeFds.push_back(true);
-    int activeCount = numOfBuilders;        // Μετρητής ενεργών FIFOs
-
-    // Επεξεργασία συνεχίζεται όσο υπάρχουν ενεργά FIFOs
-    while (activeCount > 0) {
-        for (int i = 0; i < numOfBuilders; i++) { 
-            if (activeFds[i]) {     // Ελέγχουμε αν το FIFO είναι ακόμα ενεργό
-                ssize_t bytes_read = read(allpipeTOPK[i], buffer, buffer_size - 1);
-                if (bytes_read == -1) {     // Σφάλμα ανάγνωσης
-                    std::perror("read");
-                    std::exit(EXIT_FAILURE);  
+        for (int e = 0; e < ready; e++) {
+            EventSource source = static_cast<EventSource>(events[e].data.u64 >> 32);
+            int index = static_cast<int>(events[e].data.u64 & 0xffffffffu);
+
+            if (source == SOURCE_SPLITTER_DONE || source == SOURCE_BUILDER_DONE) {
+                const List<PipeFD>& pipes = source == SOURCE_SPLITTER_DONE ? allpipeUSR1 : allpipeUSR2;
+                currentNode = pipes.getHead();
+                for (int i = 0; i < index; i++) currentNode = currentNode->next;
+                int fd = currentNode->data.fd[0];
+                if (source == SOURCE_SPLITTER_DONE) {
+                    readDoneMessage(fd, "SplitterDone", resultUSR1);
+                } else {
+                    readDoneMessage(fd, "BuilderDonee", resultUSR2);
                 }
-                if (bytes_read == 0) {      // EOF, κλείσιμο του FIFO
-                    activeFds[i] = false;
-                    activeCount--;
-                    break; 
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, NULL);
+                close(fd);
+                openSources--;
+            } else if (source == SOURCE_BUILDER_STREAM) {
+                if (streams[index].eof) continue;   // Η ροή έκλεισε ήδη σε προηγούμενο γεγονός του ίδιου γύρου
+                if (readFollowStream(epollFd, streams[index]) && streams[index].eof) openSources--;
+            } else if (source == SOURCE_INPUT) {
+                char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+                ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+                for (ssize_t offset = 0; offset < length; ) {
+                    const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+                    if (event->mask & IN_MODIFY) grown = true;
+                    if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) && !stopping) {
+                        std::cerr << "Input file was moved or deleted, stopping" << std::endl;
+                        stopFollowing(allpipeControl, epollFd, inotifyFd, timerFd, openSources);
+                        stopping = true;
+                        break;
+                    }
+                    offset += sizeof(struct inotify_event) + event->len;
                 }
-
-                buffer[bytes_read] = '\0';      // Εξασφαλίζουμε τερματισμό της συμβολοσειράς
-
-                // Διαχωρισμός λέξεων χρησιμοποιώντας strtok
-                char* token = strtok(buffer, " \n");
-                while (token != NULL) {
-                    // Επεξεργασία της λέξης 
-                    WordCount wc;
-
-                    // Βρίσκουμε τη θέση του '-'
-                    char* hyphen = strchr(token, '-');
-                    if (hyphen != nullptr) {
-                        *hyphen = '\0'; // Αντικαθιστούμε το '-' με '\0' για να τερματίσουμε τη λέξη
-
-                        // Αντιγράφουμε τη λέξη στο wc.word
-                        strncpy(wc.word, token, sizeof(wc.word));
-                        wc.word[sizeof(wc.word) - 1] = '\0'; // Εξασφαλίζουμε ότι τερματίζεται με '\0'
-
-                        // Μετατροπή του αριθμού (count) σε ακέραιο
-                        wc.count = atoi(hyphen + 1);
-                    } else {
-                        // Διαχείριση σφάλματος: Δεν βρέθηκε '-'
-                        std::perror("Error: Invalid token format.");
-                        std::exit(EXIT_FAILURE);  
+            } else if (source == SOURCE_TIMER) {
+                uint64_t expirations;
+                if (read(timerFd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN) std::perror("read timerfd");
+                if (stopping || inFlight || !grown) continue;
+                grown = false;
+
+                // Μόνο οι πλήρεις γραμμές που προστέθηκαν μετά την τελευταία αποστολή
+                struct stat st;
+                if (fstat(inputFd, &st) == -1 || static_cast<long long>(st.st_size) < dispatchedEnd) {
+                    std::cerr << "Input file was truncated, stopping" << std::endl;
+                    stopFollowing(allpipeControl, epollFd, inotifyFd, timerFd, openSources);
+                    stopping = true;
+                    continue;
+                }
+                long long end = lastSeparatorEnd(inputFd, dispatchedEnd, static_cast<long long>(st.st_size));
+                if (end == dispatchedEnd) continue;
+                partitionRange(inputFd, dispatchedEnd, end, params.numOfSplitter, boundaries);
+
+                currentNode = allpipeControl.getHead();
+                for (int i = 0; currentNode != nullptr; i++, currentNode = currentNode->next) {
+                    RangeMessage range = { boundaries[i], boundaries[i + 1] };
+                    if (write(currentNode->data.fd[1], &range, sizeof(range)) != static_cast<ssize_t>(sizeof(range))) {
+                        std::perror("write control pipe");
+                        childrenOk = false;
+                    }
+                }
+                dispatchedEnd = end;
+                inFlight = true;
+            } else {
+                // Σήματα: τερματισμοί παιδιών ή αίτημα τερματισμού της παρακολούθησης
+                struct signalfd_siginfo info[8];
+                ssize_t length = read(signalFd, info, sizeof(info));
+                if (length == -1 && errno != EAGAIN) {
+                    std::perror("read signalfd");
+                }
+                for (ssize_t k = 0; k < length / static_cast<ssize_t>(sizeof(info[0])); k++) {
+                    if (info[k].ssi_signo != SIGCHLD && !stopping) {
+                        stopFollowing(allpipeControl, epollFd, inotifyFd, timerFd, openSources);
+                        stopping = true;
+                    }
+                }
+                int status;
+                pid_t child;
+                while (children > 0 && (child = waitpid(-1, &status, WNOHANG)) > 0) {
+                    children--;
+                    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                        std::cerr << "Child process " << child << " terminated abnormally (status " << status << ")" << std::endl;
+                        if (childrenOk && ringMesh != nullptr) ringMesh->abortAll();
+                        childrenOk = false;
+                    }
+                }
+                // Χωρίς όλα τα παιδιά δεν ολοκληρώνονται άλλες εποχές
+                if (!childrenOk && !stopping) {
+                    stopFollowing(allpipeControl, epollFd, inotifyFd, timerFd, openSources);
+                    stopping = true;
+                }
+                if (children == 0) {
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, signalFd, NULL);
+                    openSources--;
+
+                    // Ροές builders που τερμάτισαν χωρίς να ανοίξουν το FIFO τους (όπως στον runEventLoop)
+                    for (int jj = 0; jj < params.numOfBuilders; jj++) {
+                        if (streams[jj].eof) continue;
+                        while (!streams[jj].eof && readFollowStream(epollFd, streams[jj])) {}
+                        if (streams[jj].eof) openSources--;
                     }
-
-                    wordCounts.push_back(wc);        // Προσθήκη του WordCount στο vector αποτελεσμάτων
-
-
-                    // Επεξεργασία επόμενης λέξης
-                    token = strtok(NULL, " \n");
                 }
             }
         }
+
+        // Νέα στιγμιότυπα από όλους τους builders
+        while (publishSegments(params, streams, dispatchedEnd, vecTopK)) inFlight = false;
     }
+    close(epollFd);
 
-    // Κλείσιμο όλων των pipes
-    for (size_t i = 0; i < allpipeTOPK.get_size(); i++) close(allpipeTOPK[i]);
+    for (int i = 0; i < params.numOfBuilders; i++) freeResults(streams[i].segment);
+    delete[] streams;
 
-    return wordCounts;       // Επιστροφή του vector με τα αποτελέσματα
+    if (resultUSR1.received != params.numOfSplitter) {
+        std::cerr << "Expected " << params.numOfSplitter << " SplitterDone messages, but received " << resultUSR1.received << std::endl;
+    }
+    if (resultUSR2.received != params.numOfBuilders) {
+        std::cerr << "Expected " << params.numOfBuilders << " BuilderDonee messages, but received " << resultUSR2.received << std::endl;
+    }
+    return childrenOk;
 }
 
-template <typename T, typename Compare>
-void vector_sort(Vector<T>& vec, Compare comp) {
-    size_t n = vec.get_size();
-    // Εφαρμογή αλγορίθμου ταξινόμησης
-    for (size_t i = 0; i < n - 1; ++i) {
-        for (size_t j = 0; j < n - i - 1; ++j) {
-            // Χρήση της συνάρτησης σύγκρισης comp για να αποφασιστεί η σειρά
-            if (comp(vec[j + 1], vec[j])) {
-                // Ανταλλαγή των στοιχείων vec[j] και vec[j + 1]
-                T temp = vec[j];
-                vec[j] = vec[j + 1];
-                vec[j + 1] = temp;
+void readDoneMessage(int fd, const char* acceptBuffer, USRResult& result) {
+    // Δημιουργούμε έναν buffer για την αποθήκευση του μηνύματος
+    const size_t buffer_size = PIPE_BUF;
+    char buffer[buffer_size];
+
+    ssize_t bytesRead = read(fd, buffer, buffer_size - 1);
+    if (bytesRead > 0) {
+        buffer[bytesRead] = '\0'; // Τερματίζουμε τη συμβολοσειρά
+
+        // Έλεγχος αν το μήνυμα ξεκινάει με το acceptBuffer
+        if (strncmp(buffer, acceptBuffer, strlen(acceptBuffer)) == 0) {
+            int id;
+            ProcessStats stats;
+
+            // Εξαγωγή του `id`, των χρόνων και των μετρητών από τη συμβολοσειρά
+            if (parseDoneMessage(buffer, acceptBuffer, id, stats)) {   // Έλεγχος επιτυχίας
+                // Αποθήκευση στο vector στην κατάλληλη θέση
+                if (id >= 0 && static_cast<size_t>(id) < result.stats.get_size()) {
+                    result.stats[id] = stats;
+                } else {
+                    std::cerr << "Invalid Splitter ID: " << id << std::endl;
+                }
+                result.received++;
+            } else {
+                std::cerr << "Failed to parse message: " << buffer << std::endl;
             }
         }
+    } else if (bytesRead == 0) {
+        perror("Pipe closed without receiving ");
+    } else {        // Σφάλμα κατά την ανάγνωση
+        perror("read failed");
     }
 }
 
-void writeResultsToFile(const Parameters& params, const Vector<WordCount>& vecTopK) {
+HeadStatus decodeHead(BuilderStream& stream) {
+    WireRecord record;
+    WireStatus status = stream.reader.next(record);
+    if (status == WIRE_ERROR || status == WIRE_MARK) {
+        std::cerr << "Error: Invalid data from builder." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    if (status == WIRE_RECORD) {
+        // Αντιγραφή της λέξης, αφού η εγγραφή δείχνει μέσα στον buffer του reader
+        stream.head.word = new char[record.length + 1];
+        memcpy(stream.head.word, record.word, record.length);
+        stream.head.word[record.length] = '\0';
+        stream.head.count = static_cast<long long>(record.count);
+        stream.head.error = static_cast<long long>(record.error);
+        return HEAD_READY;
+    }
+
+    // Η εγγραφή δεν έχει φτάσει ολόκληρη
+    if (!stream.eof) return HEAD_NEED_DATA;
+    if (!stream.reader.empty()) {
+        std::cerr << "Error: Truncated data from builder." << std::endl;
+        std::exit(EXIT_FAILURE);
+    }
+    return HEAD_END;
+}
+
+bool ranksBefore(const WordCount& a, const WordCount& b) {
+    if (a.count != b.count) return a.count > b.count;
+    return strcmp(a.word, b.word) < 0;
+}
+
+void freeResults(Vector<WordCount>& vecTopK) {
+    for (size_t i = 0; i < vecTopK.get_size(); i++) delete[] vecTopK[i].word;
+}
+
+void writeResultsToFile(const Parameters& params, const char* path, const Vector<WordCount>& vecTopK) {
+    TraceSpan span("write output");
+
     // Άνοιγμα του αρχείου για εγγραφή
-    int fd = open(params.outputFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
     if (fd == -1) {
         std::perror("open");
         return;
@@ -481,11 +1603,12 @@ void writeResultsToFile(const Parameters& params, const Vector<WordCount>& vecTo
     // Δημιουργία και εγγραφή της κεφαλίδας
     char header[256];
     int padding = maxWordLength - 4 + 5;  // 4 είναι το μήκος του "Word"
-    snprintf(header, sizeof(header), "     Word%*sFrequency\n", padding, "");  // Προσθέτουμε κενά για στοίχιση
+    bool approx = params.approxEpsilon > 0;
+    snprintf(header, sizeof(header), approx ? "     Word%*sFrequency   At least\n" : "     Word%*sFrequency\n", padding, "");  // Προσθέτουμε κενά για στοίχιση
     write(fd, header, std::strlen(header));
 
     // Γραμμή διαχωρισμού
-    int separatorLength = maxWordLength + 19;
+    int separatorLength = maxWordLength + (approx ? 31 : 19);
     char separator[separatorLength + 1];
     memset(separator, '-', separatorLength);
     separator[separatorLength] = '\n';
@@ -495,7 +1618,14 @@ void writeResultsToFile(const Parameters& params, const Vector<WordCount>& vecTo
     for (size_t i = 0; i < static_cast<size_t>(params.topK) && i < vecTopK.get_size(); i++) {
         char line[512];
         padding = maxWordLength - std::strlen(vecTopK[i].word) + 5;
-        snprintf(line, sizeof(line), "%3lu. %s%*s%d\n", i + 1, vecTopK[i].word, padding, "", vecTopK[i].count);
+        if (approx) {
+            // Με --approx το πραγματικό πλήθος βρίσκεται στο [count - error, count]: το Space-Saving
+            // μόνο υπερεκτιμά, οπότε εμφανίζεται το κάτω όριο και όχι ένα συμμετρικό σφάλμα
+            snprintf(line, sizeof(line), "%3lu. %s%*s%-9lld   >= %lld\n", i + 1, vecTopK[i].word, padding, "", vecTopK[i].count,
+                     vecTopK[i].count - vecTopK[i].error);
+        } else {
+            snprintf(line, sizeof(line), "%3lu. %s%*s%lld\n", i + 1, vecTopK[i].word, padding, "", vecTopK[i].count);
+        }
         write(fd, line, std::strlen(line));
     }
 
@@ -506,18 +1636,27 @@ void writeResultsToFile(const Parameters& params, const Vector<WordCount>& vecTo
     close(fd);
 }
 
-void printResults(const Vector<WordCount>& vecTopK, int topK, const USRResult& resultUSR1, const USRResult& resultUSR2) {
+// Στοιχεία getrusage ενός splitter ή builder
+static void printUsage(const ProcessStats& st) {
+    std::cout << "    Usage: " << st.minorFaults << " minor / " << st.majorFaults << " major page faults, "
+              << st.voluntarySwitches << " voluntary / " << st.involuntarySwitches << " involuntary context switches, max RSS "
+              << st.maxRssKb << " KB" << std::endl;
+}
+
+void printResults(const Parameters& params, const Vector<WordCount>& vecTopK, const USRResult& resultUSR1, const USRResult& resultUSR2) {
+    size_t topK = static_cast<size_t>(params.topK);
     // Εκτύπωση κορυφαίων λέξεων
     std::cout << std::endl;
     std::cout << "     Word                  Frequency" << std::endl;
     std::cout << "------------------------------------" << std::endl;
 
-    for (int i = 0; i < topK; ++i) {
+    for (size_t i = 0; i < topK && i < vecTopK.get_size(); ++i) {
         const WordCount& wc = vecTopK[i]; // Υποθέτουμε ότι WordCount έχει μέλη `word` και `count`
         std::cout << std::setw(4) << std::right << i + 1 << ". "    // Αριθμός με δεξιά στοίχιση
                   << std::setw(15) << std::left << wc.word          // Λέξη με αριστερή στοίχιση
-                  << std::setw(10) << std::right << wc.count        // Συχνότητα με δεξιά στοίχιση
-                  << std::endl;
+                  << std::setw(10) << std::right << wc.count;       // Συχνότητα με δεξιά στοίχιση
+        if (params.approxEpsilon > 0) std::cout << " (>= " << wc.count - wc.error << ")";  // Κάτω όριο με --approx
+        std::cout << std::endl;
     }
 
     std::cout << "------------------------------------" << std::endl;
@@ -525,20 +1664,313 @@ void printResults(const Vector<WordCount>& vecTopK, int topK, const USRResult& r
     // Εκτύπωση αποτελεσμάτων splitters
     std::cout << std::endl;
     std::cout << "Splitter Results:" << std::endl;
-    for (size_t i = 0; i < resultUSR1.times.get_size(); ++i) {
-        std::cout << "Splitter " << i << " Real Time: " << resultUSR1.times[i].real_time
-                  << ", CPU Time: " << resultUSR1.times[i].cpu_time << std::endl;
+    for (size_t i = 0; i < resultUSR1.stats.get_size(); ++i) {
+        const ProcessStats& st = resultUSR1.stats[i];
+        std::cout << "Splitter " << i << " Real Time: " << st.realTime << ", CPU Time: " << st.cpuTime << std::endl;
+        std::cout << "    Input: " << st.bytesRead << " bytes, " << st.linesRead << " lines, " << st.readCalls << " read calls";
+        if (st.chunks > 0) std::cout << ", " << st.chunks << " chunks";
+        std::cout << std::endl;
+        std::cout << "    Words: " << st.words << " (excluded " << st.excluded << "), too short " << st.tooShort << std::endl;
+        std::cout << "    Output: " << st.writeCalls << " write calls, blocked " << st.writeBlocked << " s, records per builder:";
+        for (size_t j = 0; j < st.sent.get_size(); ++j) std::cout << " " << st.sent[j];
+        std::cout << std::endl;
+        printUsage(st);
     }
 
     // Εκτύπωση αποτελεσμάτων builders
     std::cout << "Builder Results:" << std::endl;
-    for (size_t i = 0; i < resultUSR2.times.get_size(); ++i) {
-        std::cout << "Builder " << i << " Real Time: " << resultUSR2.times[i].real_time
-                  << ", CPU Time: " << resultUSR2.times[i].cpu_time << std::endl;
+    for (size_t i = 0; i < resultUSR2.stats.get_size(); ++i) {
+        const ProcessStats& st = resultUSR2.stats[i];
+        std::cout << "Builder " << i << " Real Time: " << st.realTime << ", CPU Time: " << st.cpuTime << std::endl;
+        std::cout << "    Input: " << st.bytesRead << " bytes, " << st.readCalls << " reads, blocked " << st.readBlocked << " s" << std::endl;
+        std::cout << "    Words: " << st.words << " in " << st.records << " records, " << st.distinctWords << " distinct, table "
+                  << st.tableBytes << " bytes" << std::endl;
+        printUsage(st);
     }
 
     // Εκτύπωση αριθμού σημάτων
     std::cout << std::endl;
     std::cout << "USR1 Signals Received: " << resultUSR1.received << std::endl;
     std::cout << "USR2 Signals Received: " << resultUSR2.received << std::endl;
-}
\ No newline at end of file
+}
+// Ένα πεδίο της αναφοράς με την τιμή του ήδη μορφοποιημένη
+struct ReportField {
+    char key[32];
+    char value[272];
+    bool text;          // Συμβολοσειρά (σε JSON μέσα σε εισαγωγικά)
+};
+
+// Ομάδα πεδίων της αναφοράς: ένα αντικείμενο (parameters, run, imbalance) ή λίστα αντικειμένων
+struct ReportSection {
+    const char* name;
+    bool list;
+    Vector<Vector<ReportField> > records;
+};
+
+static void addNumber(Vector<ReportField>& record, const char* key, const char* format, double number) {
+    ReportField field;
+    snprintf(field.key, sizeof(field.key), "%s", key);
+    snprintf(field.value, sizeof(field.value), format, number);
+    field.text = false;
+    record.push_back(field);
+}
+
+static void addInteger(Vector<ReportField>& record, const char* key, long long number) {
+    ReportField field;
+    snprintf(field.key, sizeof(field.key), "%s", key);
+    snprintf(field.value, sizeof(field.value), "%lld", number);
+    field.text = false;
+    record.push_back(field);
+}
+
+static void addReal(Vector<ReportField>& record, const char* key, double number) {
+    addNumber(record, key, "%.6f", number);
+}
+
+static void addText(Vector<ReportField>& record, const char* key, const char* text) {
+    ReportField field;
+    snprintf(field.key, sizeof(field.key), "%s", key);
+    snprintf(field.value, sizeof(field.value), "%s", text);
+    field.text = true;
+    record.push_back(field);
+}
+
+static void addBool(Vector<ReportField>& record, const char* key, bool value) {
+    ReportField field;
+    snprintf(field.key, sizeof(field.key), "%s", key);
+    snprintf(field.value, sizeof(field.value), "%s", value ? "true" : "false");
+    field.text = false;
+    record.push_back(field);
+}
+
+// Οι χρόνοι και οι μετρητές ενός splitter ή builder
+static void addStats(Vector<ReportField>& record, const ProcessStats& st, bool splitter) {
+    addReal(record, "realTime", st.realTime);
+    addReal(record, "cpuTime", st.cpuTime);
+    addInteger(record, "bytesRead", st.bytesRead);
+    if (splitter) {
+        addInteger(record, "linesRead", st.linesRead);
+        addInteger(record, "chunks", st.chunks);
+    }
+    addInteger(record, "readCalls", st.readCalls);
+    if (!splitter) addReal(record, "readBlocked", st.readBlocked);
+    addInteger(record, "words", st.words);
+    if (splitter) {
+        addInteger(record, "excluded", st.excluded);
+        addInteger(record, "tooShort", st.tooShort);
+    } else {
+        addInteger(record, "records", st.records);
+        addInteger(record, "distinctWords", st.distinctWords);
+        addInteger(record, "tableBytes", st.tableBytes);
+    }
+    addInteger(record, "writeCalls", st.writeCalls);
+    if (splitter) {
+        addReal(record, "writeBlocked", st.writeBlocked);
+        for (size_t j = 0; j < st.sent.get_size(); j++) {
+            char key[32];
+            snprintf(key, sizeof(key), "sentToBuilder%u", static_cast<unsigned>(j));
+            addInteger(record, key, st.sent[j]);
+        }
+    }
+    addInteger(record, "minorFaults", st.minorFaults);
+    addInteger(record, "majorFaults", st.majorFaults);
+    addInteger(record, "voluntarySwitches", st.voluntarySwitches);
+    addInteger(record, "involuntarySwitches", st.involuntarySwitches);
+    addInteger(record, "maxRssKb", st.maxRssKb);
+}
+
+// Μέγιστη και μέση τιμή και ο λόγος τους (1 = ισοκατανομή)
+static void addImbalance(Vector<ReportField>& record, const char* name, const Vector<double>& values) {
+    double max = 0, sum = 0;
+    for (size_t i = 0; i < values.get_size(); i++) {
+        if (values[i] > max) max = values[i];
+        sum += values[i];
+    }
+    double mean = values.get_size() > 0 ? sum / values.get_size() : 0;
+    char key[32];
+    snprintf(key, sizeof(key), "%sMax", name);
+    addReal(record, key, max);
+    snprintf(key, sizeof(key), "%sMean", name);
+    addReal(record, key, mean);
+    snprintf(key, sizeof(key), "%sMaxOverMean", name);
+    addReal(record, key, mean > 0 ? max / mean : 0);
+}
+
+// Συμβολοσειρά JSON με διαφυγή των ειδικών χαρακτήρων
+static void writeJsonString(FILE* out, const char* text) {
+    std::fputc('"', out);
+    for (const unsigned char* p = reinterpret_cast<const unsigned char*>(text); *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') std::fprintf(out, "\\%c", *p);
+        else if (*p < 0x20) std::fprintf(out, "\\u%04x", *p);
+        else std::fputc(*p, out);
+    }
+    std::fputc('"', out);
+}
+
+static void writeJsonRecord(FILE* out, const Vector<ReportField>& record) {
+    std::fputc('{', out);
+    for (size_t f = 0; f < record.get_size(); f++) {
+        if (f > 0) std::fputs(", ", out);
+        writeJsonString(out, record[f].key);
+        std::fputs(": ", out);
+        if (record[f].text) writeJsonString(out, record[f].value);
+        else std::fputs(record[f].value, out);
+    }
+    std::fputc('}', out);
+}
+
+// Τιμή CSV, σε εισαγωγικά αν περιέχει κόμμα, εισαγωγικά ή αλλαγή γραμμής
+static void writeCsvValue(FILE* out, const char* text) {
+    if (std::strpbrk(text, ",\"\n\r") == NULL) {
+        std::fputs(text, out);
+        return;
+    }
+    std::fputc('"', out);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"') std::fputc('"', out);
+        std::fputc(*p, out);
+    }
+    std::fputc('"', out);
+}
+
+void writeReport(const Parameters& params, double realTime, const Vector<WordCount>& vecTopK, const USRResult& resultUSR1,
+                 const USRResult& resultUSR2) {
+    ReportSection sections[6] = {
+        { "parameters", false, Vector<Vector<ReportField> >() },
+        { "run", false, Vector<Vector<ReportField> >() },
+        { "imbalance", false, Vector<Vector<ReportField> >() },
+        { "topK", true, Vector<Vector<ReportField> >() },
+        { "splitters", true, Vector<Vector<ReportField> >() },
+        { "builders", true, Vector<Vector<ReportField> >() },
+    };
+
+    Vector<ReportField> record;
+    addText(record, "input", params.inputFile);
+    addText(record, "output", params.outputFile);
+    addText(record, "exclusion", params.exclusionFile);
+    addInteger(record, "splitters", params.numOfSplitter);
+    addInteger(record, "builders", params.numOfBuilders);
+    addInteger(record, "topK", params.topK);
+    addText(record, "reader", params.readerBackend);
+    addInteger(record, "batch", params.batchSize);
+    addBool(record, "wireHashes", params.wireHashes);
+    addInteger(record, "combine", params.combineBytes);
+    addText(record, "tokenizer", params.tokenizerKernel);
+    addBool(record, "threads", params.threads);
+    addText(record, "transport", params.transport);
+    addReal(record, "follow", params.followInterval);
+    addNumber(record, "approx", "%.17g", params.approxEpsilon);
+    addInteger(record, "memBudget", params.memBudget);
+    addInteger(record, "chunk", params.chunkBytes);
+    sections[0].records.push_back(record);
+
+    // Σύνολα της εκτέλεσης
+    long long bytesRead = 0, words = 0;
+    for (size_t i = 0; i < resultUSR1.stats.get_size(); i++) bytesRead += resultUSR1.stats[i].bytesRead;
+    for (size_t j = 0; j < resultUSR2.stats.get_size(); j++) words += resultUSR2.stats[j].words;
+    record.clear();
+    addReal(record, "realTime", realTime);
+    addInteger(record, "bytesRead", bytesRead);
+    addReal(record, "mbPerSecond", realTime > 0 ? bytesRead / 1048576.0 / realTime : 0);
+    addInteger(record, "wordsCounted", words);
+    addInteger(record, "splittersDone", resultUSR1.received);
+    addInteger(record, "buildersDone", resultUSR2.received);
+    sections[1].records.push_back(record);
+
+    // Ανισορροπία φορτίου: λέξεις ανά builder και χρόνοι splitters και builders
+    Vector<double> builderWords, builderTimes, splitterTimes;
+    for (size_t i = 0; i < resultUSR1.stats.get_size(); i++) splitterTimes.push_back(resultUSR1.stats[i].realTime);
+    for (size_t j = 0; j < resultUSR2.stats.get_size(); j++) {
+        builderWords.push_back(static_cast<double>(resultUSR2.stats[j].words));
+        builderTimes.push_back(resultUSR2.stats[j].realTime);
+    }
+    record.clear();
+    addImbalance(record, "builderWords", builderWords);
+    addImbalance(record, "splitterTime", splitterTimes);
+    addImbalance(record, "builderTime", builderTimes);
+    sections[2].records.push_back(record);
+
+    for (size_t i = 0; i < static_cast<size_t>(params.topK) && i < vecTopK.get_size(); i++) {
+        record.clear();
+        addInteger(record, "rank", static_cast<long long>(i + 1));
+        addText(record, "word", vecTopK[i].word);
+        addInteger(record, "count", vecTopK[i].count);
+        if (params.approxEpsilon > 0) {
+            addInteger(record, "error", vecTopK[i].error);
+            addInteger(record, "minCount", vecTopK[i].count - vecTopK[i].error);
+        }
+        sections[3].records.push_back(record);
+    }
+    for (size_t i = 0; i < resultUSR1.stats.get_size(); i++) {
+        record.clear();
+        addInteger(record, "id", static_cast<long long>(i));
+        addStats(record, resultUSR1.stats[i], true);
+        sections[4].records.push_back(record);
+    }
+    for (size_t j = 0; j < resultUSR2.stats.get_size(); j++) {
+        record.clear();
+        addInteger(record, "id", static_cast<long long>(j));
+        addStats(record, resultUSR2.stats[j], false);
+        sections[5].records.push_back(record);
+    }
+
+    bool json = strcmp(params.reportFormat, "json") == 0;
+    char path[300];
+    snprintf(path, sizeof(path), "%s.%s", params.outputFile, params.reportFormat);
+    FILE* out = std::fopen(path, "w");
+    if (out == NULL) {
+        std::perror("fopen report");
+        return;
+    }
+
+    if (json) {
+        std::fputs("{\n", out);
+        for (int s = 0; s < 6; s++) {
+            std::fprintf(out, "  \"%s\": ", sections[s].name);
+            if (!sections[s].list) {
+                writeJsonRecord(out, sections[s].records[0]);
+            } else {
+                std::fputc('[', out);
+                for (size_t r = 0; r < sections[s].records.get_size(); r++) {
+                    std::fputs(r > 0 ? ",\n    " : "\n    ", out);
+                    writeJsonRecord(out, sections[s].records[r]);
+                }
+                std::fputs(sections[s].records.get_size() > 0 ? "\n  ]" : "]", out);
+            }
+            std::fputs(s < 5 ? ",\n" : "\n", out);
+        }
+        std::fputs("}\n", out);
+    } else {
+        // Μία γραμμή ανά πεδίο, ώστε όλες οι ομάδες να χωρούν στις ίδιες στήλες
+        std::fputs("section,index,key,value\n", out);
+        for (int s = 0; s < 6; s++) {
+            for (size_t r = 0; r < sections[s].records.get_size(); r++) {
+                const Vector<ReportField>& fields = sections[s].records[r];
+                for (size_t f = 0; f < fields.get_size(); f++) {
+                    std::fprintf(out, "%s,", sections[s].name);
+                    if (sections[s].list) std::fprintf(out, "%lu", static_cast<unsigned long>(r));
+                    std::fprintf(out, ",%s,", fields[f].key);
+                    writeCsvValue(out, fields[f].value);
+                    std::fputc('\n', out);
+                }
+            }
+        }
+    }
+
+    if (std::fclose(out) != 0) {
+        std::perror("write report");
+        return;
+    }
+    std::cout << "Report written to " << path << std::endl;
+}
+
+void finishTrace(const Parameters& params, TraceBuffer* trace, int traceFd) {
+    currentTrace = nullptr;
+    bool ok = trace->writeTo(traceFd, true);
+    if (close(traceFd) == -1) {
+        std::perror("close trace file");
+        ok = false;
+    }
+    delete trace;
+    if (ok) std::cout << "Trace written to " << params.traceFile << std::endl;
+}
@@ -0,0 +1,348 @@
+// reader.cpp
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include "reader.hpp"
+
+// Μέγεθος block για τα backends pread και io_uring
+static const size_t READ_BLOCK_SIZE = 1024 * 1024;
+
+// ---------------------------------------------------------------------------
+// mmap: όλο το τμήμα απεικονίζεται στη μνήμη και επιστρέφεται ως ένα block
+// ---------------------------------------------------------------------------
+class MmapReader : public InputReader {
+private:
+    void* map;          // Αρχή της απεικόνισης (στοιχισμένη σε σελίδα)
+    size_t mapLength;   // Μήκος της απεικόνισης
+    size_t skip;        // Απόσταση της αρχής του τμήματος από την αρχή της απεικόνισης
+    bool done;
+    bool error;
+
+public:
+    MmapReader(int fd, long long start, long long end) : map(nullptr), mapLength(0), skip(0), done(false), error(false) {
+        if (end <= start) {     // Κενό τμήμα
+            done = true;
+            return;
+        }
+        long long pageSize = sysconf(_SC_PAGESIZE);
+        long long alignedStart = start - start % pageSize;
+        skip = static_cast<size_t>(start - alignedStart);
+        mapLength = static_cast<size_t>(end - alignedStart);
+
+        map = mmap(nullptr, mapLength, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(alignedStart));
+        if (map == MAP_FAILED) {
+            std::perror("mmap");
+            map = nullptr;
+            error = done = true;
+            return;
+        }
+        madvise(map, mapLength, MADV_SEQUENTIAL);   // Ανάγνωση μπροστά από τον πυρήνα
+    }
+
+    ~MmapReader() {
+        if (map != nullptr) munmap(map, mapLength);
+    }
+
+    bool next(const char*& data, size_t& length) {
+        if (done) return false;
+        done = true;
+        data = static_cast<const char*>(map) + skip;
+        length = mapLength - skip;
+        return true;
+    }
+
+    bool failed() const { return error; }
+};
+
+// ---------------------------------------------------------------------------
+// pread: μεγάλα blocks με posix_fadvise για sequential πρόσβαση
+// ---------------------------------------------------------------------------
+class PreadReader : public InputReader {
+private:
+    int fd;
+    long long position;     // Επόμενο byte προς ανάγνωση
+    long long end;
+    char* buffer;
+    bool error;
+
+public:
+    PreadReader(int fd, long long start, long long end) : fd(fd), position(start), end(end), buffer(new char[READ_BLOCK_SIZE]), error(false) {
+        if (end > start) {
+            posix_fadvise(fd, static_cast<off_t>(start), static_cast<off_t>(end - start), POSIX_FADV_SEQUENTIAL);
+            posix_fadvise(fd, static_cast<off_t>(start), static_cast<off_t>(end - start), POSIX_FADV_WILLNEED);
+        }
+    }
+
+    ~PreadReader() {
+        delete[] buffer;
+    }
+
+    bool next(const char*& data, size_t& length) {
+        if (error || position >= end) return false;
+        size_t wanted = end - position < static_cast<long long>(READ_BLOCK_SIZE) ? static_cast<size_t>(end - position) : READ_BLOCK_SIZE;
+
+        ssize_t bytes_read = pread(fd, buffer, wanted, static_cast<off_t>(position));
+        readCalls++;
+        while (bytes_read == -1 && errno == EINTR) {
+            bytes_read = pread(fd, buffer, wanted, static_cast<off_t>(position));
+            readCalls++;
+        }
+        if (bytes_read == -1) {
+            std::perror("pread");
+            error = true;
+            return false;
+        }
+        if (bytes_read == 0) return false;  // Το αρχείο μίκρυνε
+
+        position += bytes_read;
+        data = buffer;
+        length = static_cast<size_t>(bytes_read);
+        return true;
+    }
+
+    bool failed() const { return error; }
+};
+
+// ---------------------------------------------------------------------------
+// io_uring: double buffering με απευθείας system calls (χωρίς liburing).
+// Όσο επεξεργάζεται ένα block, η ανάγνωση του επόμενου εκτελείται ήδη από τον πυρήνα.
+// ---------------------------------------------------------------------------
+class UringReader : public InputReader {
+private:
+    struct Slot {
+        char* buffer;
+        struct iovec iov;
+        long long offset;   // Θέση στο αρχείο
+        size_t wanted;      // Ζητούμενα bytes
+        bool pending;       // Έχει υποβληθεί και δεν έχει ολοκληρωθεί
+        bool inFlight;      // Έχει υποβληθεί (ολοκληρωμένο ή όχι) και δεν έχει καταναλωθεί
+        int result;         // Αποτέλεσμα της ολοκλήρωσης (bytes ή -errno)
+    };
+
+    int fd;
+    long long nextOffset;   // Επόμενη θέση προς υποβολή
+    long long end;
+    int ringFd;
+    bool error;
+
+    Slot slots[2];
+    int current;            // Slot που θα επιστραφεί στην επόμενη next()
+    int handedOut;          // Slot που επιστράφηκε στην προηγούμενη next() (-1 αν κανένα)
+
+    // Απεικονίσεις των δακτυλίων υποβολής/ολοκλήρωσης
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    struct io_uring_sqe* sqes;
+    size_t sqesSize;
+
+    unsigned* sqTail;
+    unsigned* sqMask;
+    unsigned* sqArray;
+    unsigned* cqHead;
+    unsigned* cqTail;
+    unsigned* cqMask;
+    struct io_uring_cqe* cqes;
+
+    static int setup(unsigned entries, struct io_uring_params* p) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+    }
+
+    int enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        readCalls++;
+        return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, NULL, 0));
+    }
+
+    // Υποβολή ανάγνωσης του επόμενου block στο slot
+    bool submit(int index) {
+        Slot& slot = slots[index];
+        if (nextOffset >= end) return true;     // Τίποτα άλλο προς ανάγνωση
+        slot.offset = nextOffset;
+        slot.wanted = end - nextOffset < static_cast<long long>(READ_BLOCK_SIZE) ? static_cast<size_t>(end - nextOffset) : READ_BLOCK_SIZE;
+        slot.iov.iov_base = slot.buffer;
+        slot.iov.iov_len = slot.wanted;
+        nextOffset += slot.wanted;
+
+        unsigned tail = *sqTail;
+        unsigned sqIndex = tail & *sqMask;
+        struct io_uring_sqe* sqe = &sqes[sqIndex];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<unsigned long long>(&slot.iov);
+        sqe->len = 1;
+        sqe->off = static_cast<unsigned long long>(slot.offset);
+        sqe->user_data = static_cast<unsigned long long>(index);
+        sqArray[sqIndex] = sqIndex;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+        int res = enter(ringFd, 1, 0, 0);
+        while (res == -1 && errno == EINTR) res = enter(ringFd, 1, 0, 0);
+        if (res == -1) {
+            std::perror("io_uring_enter");
+            return false;
+        }
+        slot.pending = true;
+        slot.inFlight = true;
+        return true;
+    }
+
+    // Αναμονή μέχρι να ολοκληρωθεί η ανάγνωση του slot
+    bool waitFor(int index) {
+        while (slots[index].pending) {
+            unsigned head = *cqHead;
+            unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            if (head == tail) {
+                int res = enter(ringFd, 0, 1, IORING_ENTER_GETEVENTS);
+                if (res == -1 && errno != EINTR) {
+                    std::perror("io_uring_enter");
+                    return false;
+                }
+                continue;
+            }
+            struct io_uring_cqe* cqe = &cqes[head & *cqMask];
+            Slot& done = slots[cqe->user_data];
+            done.result = cqe->res;
+            done.pending = false;
+            __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        }
+        return true;
+    }
+
+public:
+    UringReader(int fd, long long start, long long end)
+        : fd(fd), nextOffset(start), end(end), ringFd(-1), error(false), current(0), handedOut(-1),
+          sqRing(MAP_FAILED), sqRingSize(0), cqRing(MAP_FAILED), cqRingSize(0), sqes(nullptr), sqesSize(0) {
+        for (int i = 0; i < 2; i++) {
+            slots[i].buffer = new char[READ_BLOCK_SIZE];
+            slots[i].pending = slots[i].inFlight = false;
+            slots[i].result = 0;
+        }
+    }
+
+    ~UringReader() {
+        // Αναμονή για τυχόν εκκρεμείς αναγνώσεις πριν την αποδέσμευση των buffers
+        if (ringFd != -1) {
+            for (int i = 0; i < 2; i++) waitFor(i);
+        }
+        if (sqes != nullptr) munmap(sqes, sqesSize);
+        if (cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        if (ringFd != -1) close(ringFd);
+        for (int i = 0; i < 2; i++) delete[] slots[i].buffer;
+    }
+
+    // Δημιουργία του io_uring (false αν δεν υποστηρίζεται)
+    bool init() {
+        struct io_uring_params p;
+        memset(&p, 0, sizeof(p));
+        ringFd = setup(4, &p);
+        if (ringFd == -1) return false;
+
+        sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+        bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            if (cqRingSize > sqRingSize) sqRingSize = cqRingSize;
+            cqRingSize = sqRingSize;
+        }
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) return false;
+        if (single) {
+            cqRing = sqRing;
+        } else {
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED) return false;
+        }
+        sqesSize = p.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqesMap == MAP_FAILED) return false;
+        sqes = static_cast<struct io_uring_sqe*>(sqesMap);
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes = reinterpret_cast<struct io_uring_cqe*>(cq + p.cq_off.cqes);
+
+        posix_fadvise(fd, static_cast<off_t>(nextOffset), static_cast<off_t>(end - nextOffset), POSIX_FADV_SEQUENTIAL);
+
+        // Εκκίνηση των δύο πρώτων αναγνώσεων
+        return submit(0) && submit(1);
+    }
+
+    bool next(const char*& data, size_t& length) {
+        if (error) return false;
+
+        // Το block της προηγούμενης κλήσης καταναλώθηκε: επαναχρησιμοποίηση για την επόμενη ανάγνωση
+        if (handedOut != -1) {
+            slots[handedOut].inFlight = false;
+            if (!submit(handedOut)) {
+                error = true;
+                return false;
+            }
+            handedOut = -1;
+        }
+
+        Slot& slot = slots[current];
+        if (!slot.inFlight) return false;   // Τέλος του τμήματος
+        if (!waitFor(current)) {
+            error = true;
+            return false;
+        }
+        if (slot.result < 0) {
+            errno = -slot.result;
+            std::perror("io_uring read");
+            error = true;
+            return false;
+        }
+
+        // Συμπλήρωση τυχόν σύντομης ανάγνωσης ώστε τα blocks να μένουν συνεχόμενα
+        size_t got = static_cast<size_t>(slot.result);
+        while (got < slot.wanted) {
+            ssize_t bytes_read = pread(fd, slot.buffer + got, slot.wanted - got, static_cast<off_t>(slot.offset + got));
+            readCalls++;
+            if (bytes_read == -1 && errno == EINTR) continue;
+            if (bytes_read <= 0) break;
+            got += bytes_read;
+        }
+
+        data = slot.buffer;
+        length = got;
+        handedOut = current;
+        current = 1 - current;
+        return got > 0;
+    }
+
+    bool failed() const { return error; }
+};
+
+bool isReaderBackend(const char* name) {
+    return strcmp(name, "mmap") == 0 || strcmp(name, "pread") == 0 || strcmp(name, "uring") == 0;
+}
+
+InputReader* createReader(const char* backend, int fd, long long start, long long end) {
+    if (strcmp(backend, "mmap") == 0) {
+        return new MmapReader(fd, start, end);
+    }
+    if (strcmp(backend, "uring") == 0) {
+        UringReader* reader = new UringReader(fd, start, end);
+        if (reader->init()) return reader;
+        delete reader;
+        std::cerr << "io_uring unavailable, falling back to pread" << std::endl;
+    }
+    return new PreadReader(fd, start, end);
+}
@@ -0,0 +1,32 @@
+#ifndef READER_HPP
+#define READER_HPP
+
+#include <cstddef>
+
+// Αφηρημένη κλάση ανάγνωσης ενός τμήματος [start, end) του αρχείου εισόδου σε blocks.
+// Κάθε block παραμένει έγκυρο μέχρι την επόμενη κλήση της next().
+class InputReader {
+protected:
+    size_t readCalls;   // Κλήσεις συστήματος ανάγνωσης (pread, io_uring_enter)
+
+public:
+    InputReader() : readCalls(0) {}
+    virtual ~InputReader() {}
+
+    // Επιστρέφει το επόμενο block του τμήματος (false στο τέλος ή σε σφάλμα)
+    virtual bool next(const char*& data, size_t& length) = 0;
+
+    // true αν η ανάγνωση τερμάτισε λόγω σφάλματος
+    virtual bool failed() const = 0;
+
+    size_t get_readCalls() const { return readCalls; }
+};
+
+// Έλεγχος αν το όνομα αντιστοιχεί σε διαθέσιμο backend ("mmap", "pread", "uring")
+bool isReaderBackend(const char* name);
+
+// Δημιουργία reader για το τμήμα [start, end) του fd με το ζητούμενο backend.
+// Αν το io_uring δεν υποστηρίζεται από τον πυρήνα, χρησιμοποιείται το pread.
+InputReader* createReader(const char* backend, int fd, long long start, long long end);
+
+#endif // READER_HPP
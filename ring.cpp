@@ -0,0 +1,212 @@
+// ring.cpp
+#include <cstring>
+#include <climits>
+#include <new>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "ring.hpp"
+
+// Αναμονή όσο η λέξη έχει την τιμή expected (επιστρέφει αμέσως αν έχει ήδη αλλάξει)
+static void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, NULL, NULL, 0);
+}
+
+static void futexWake(std::atomic<uint32_t>* word, int count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+void Doorbell::init() {
+    sequence.store(0);
+    waiting.store(0);
+}
+
+uint32_t Doorbell::prepareWait() {
+    uint32_t current = sequence.load();
+    waiting.store(1);
+    return current;
+}
+
+void Doorbell::wait(uint32_t expected) {
+    futexWait(&sequence, expected);
+    waiting.store(0);
+}
+
+void Doorbell::ring() {
+    // Αν ο καταναλωτής δηλώσει αναμονή μετά την αύξηση, ο τελικός του έλεγχος θα δει τα δεδομένα
+    sequence.fetch_add(1);
+    if (waiting.load() != 0) futexWake(&sequence, INT_MAX);
+}
+
+void SpscRing::init(void* memory, size_t capacity) {
+    RingState* state = new (memory) RingState;
+    state->head.store(0);
+    state->tail.store(0);
+    state->space.store(0);
+    state->producerWaiting.store(0);
+    state->closed.store(0);
+    state->aborted.store(0);
+    state->capacity = static_cast<uint32_t>(capacity);
+}
+
+SpscRing::SpscRing(void* memory, Doorbell* doorbell)
+    : state(static_cast<RingState*>(memory)), data(static_cast<char*>(memory) + sizeof(RingState)), doorbell(doorbell) {}
+
+bool SpscRing::write(const char* bytes, size_t count) {
+    size_t capacity = state->capacity;
+    uint64_t head = state->head.load(std::memory_order_relaxed);
+    while (count > 0) {
+        if (state->aborted.load() != 0) return false;
+        size_t space = capacity - static_cast<size_t>(head - state->tail.load(std::memory_order_acquire));
+        if (space == 0) {
+            // Γεμάτος: αναμονή μέχρι ο καταναλωτής να ελευθερώσει χώρο
+            uint32_t expected = state->space.load();
+            state->producerWaiting.store(1);
+            if (head - state->tail.load() == capacity && state->aborted.load() == 0) futexWait(&state->space, expected);
+            state->producerWaiting.store(0);
+            continue;
+        }
+
+        // Αντιγραφή σε έως δύο κομμάτια λόγω της αναδίπλωσης
+        size_t n = count < space ? count : space;
+        size_t offset = static_cast<size_t>(head) & (capacity - 1);
+        size_t first = n < capacity - offset ? n : capacity - offset;
+        std::memcpy(data + offset, bytes, first);
+        std::memcpy(data, bytes + first, n - first);
+
+        // Δημοσίευση πριν από τον έλεγχο του κουδουνιού (ζεύγος με την prepareWait του καταναλωτή)
+        head += n;
+        state->head.store(head);
+        doorbell->ring();
+        bytes += n;
+        count -= n;
+    }
+    return true;
+}
+
+void SpscRing::close() {
+    state->closed.store(1);
+    doorbell->ring();
+}
+
+size_t SpscRing::read(char* buffer, size_t max) {
+    size_t capacity = state->capacity;
+    uint64_t tail = state->tail.load(std::memory_order_relaxed);
+    size_t available = static_cast<size_t>(state->head.load(std::memory_order_acquire) - tail);
+    size_t n = available < max ? available : max;
+    if (n == 0) return 0;
+
+    size_t offset = static_cast<size_t>(tail) & (capacity - 1);
+    size_t first = n < capacity - offset ? n : capacity - offset;
+    std::memcpy(buffer, data + offset, first);
+    std::memcpy(buffer + first, data, n - first);
+
+    // Ελευθέρωση του χώρου και αφύπνιση του παραγωγού μόνο αν περιμένει
+    state->tail.store(tail + n);
+    state->space.fetch_add(1);
+    if (state->producerWaiting.load() != 0) futexWake(&state->space, 1);
+    return n;
+}
+
+bool SpscRing::finished() const {
+    // Το closed διαβάζεται πρώτο: αν έχει τεθεί, όλα τα δεδομένα του παραγωγού είναι ήδη ορατά
+    if (state->closed.load() == 0) return false;
+    return state->head.load() == state->tail.load(std::memory_order_relaxed);
+}
+
+bool SpscRing::pending() const {
+    return state->closed.load() != 0 || state->head.load() != state->tail.load(std::memory_order_relaxed);
+}
+
+void SpscRing::abort() {
+    state->aborted.store(1);
+    state->closed.store(1);
+    // Αφύπνιση και των δύο πλευρών
+    state->space.fetch_add(1);
+    futexWake(&state->space, INT_MAX);
+    doorbell->ring();
+}
+
+RingMesh::~RingMesh() {
+    if (memory != nullptr) munmap(memory, bytes);
+}
+
+size_t RingMesh::capacityFor(size_t batchSize) {
+    size_t capacity = 64;
+    while (capacity < 2 * batchSize) capacity *= 2;
+    return capacity;
+}
+
+bool RingMesh::create(int numOfSplitters, int numOfBuilders, size_t capacity, int fd) {
+    ringBytes = (SpscRing::bytesFor(capacity) + 63) & ~static_cast<size_t>(63);
+    bytes = 64 + static_cast<size_t>(numOfBuilders) * 64 + static_cast<size_t>(numOfSplitters) * numOfBuilders * ringBytes;
+
+    void* mapped;
+    if (fd >= 0) {
+        if (ftruncate(fd, static_cast<off_t>(bytes)) == -1) {
+            std::perror("ftruncate ring mesh");
+            return false;
+        }
+        mapped = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    } else {
+        mapped = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (mapped == MAP_FAILED) {
+        std::perror("mmap ring mesh");
+        return false;
+    }
+    memory = static_cast<char*>(mapped);
+
+    RingMeshHeader* h = reinterpret_cast<RingMeshHeader*>(memory);
+    h->magic = RING_MESH_MAGIC;
+    h->numOfSplitters = static_cast<uint32_t>(numOfSplitters);
+    h->numOfBuilders = static_cast<uint32_t>(numOfBuilders);
+    h->capacity = static_cast<uint32_t>(capacity);
+    for (int j = 0; j < numOfBuilders; j++) doorbell(j)->init();
+    for (int i = 0; i < numOfSplitters; i++) {
+        for (int j = 0; j < numOfBuilders; j++) SpscRing::init(ring(i, j), capacity);
+    }
+    return true;
+}
+
+bool RingMesh::attach(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        std::perror("fstat ring mesh");
+        return false;
+    }
+    void* mapped = mmap(NULL, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        std::perror("mmap ring mesh");
+        return false;
+    }
+    memory = static_cast<char*>(mapped);
+    bytes = static_cast<size_t>(st.st_size);
+
+    // Έλεγχος ότι το μέγεθος συμφωνεί με την κεφαλίδα
+    const RingMeshHeader& h = header();
+    if (bytes < sizeof(RingMeshHeader) || h.magic != RING_MESH_MAGIC) {
+        std::fprintf(stderr, "Invalid ring mesh\n");
+        return false;
+    }
+    ringBytes = (SpscRing::bytesFor(h.capacity) + 63) & ~static_cast<size_t>(63);
+    if (64 + static_cast<size_t>(h.numOfBuilders) * 64 + static_cast<size_t>(h.numOfSplitters) * h.numOfBuilders * ringBytes != bytes) {
+        std::fprintf(stderr, "Invalid ring mesh size\n");
+        return false;
+    }
+    return true;
+}
+
+void* RingMesh::ring(int splitter, int builder) const {
+    size_t first = 64 + static_cast<size_t>(header().numOfBuilders) * 64;
+    return memory + first + (static_cast<size_t>(splitter) * header().numOfBuilders + builder) * ringBytes;
+}
+
+void RingMesh::abortAll() {
+    for (int i = 0; i < numOfSplitters(); i++) {
+        for (int j = 0; j < numOfBuilders(); j++) SpscRing(ring(i, j), doorbell(j)).abort();
+    }
+}
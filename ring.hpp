@@ -0,0 +1,136 @@
+#ifndef RING_HPP
+#define RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+// Δακτύλιος bytes ενός παραγωγού και ενός καταναλωτή (SPSC) χωρίς κλειδώματα, για τη μεταφορά
+// της ροής του πρωτοκόλλου από έναν splitter σε έναν builder χωρίς αντιγραφές μέσω του πυρήνα.
+//
+// Η κατάσταση (RingState) και τα δεδομένα βρίσκονται σε ένα συνεχόμενο κομμάτι μνήμης χωρίς δείκτες,
+// ώστε να μπορεί να τοποθετηθεί και σε κοινή μνήμη μεταξύ διεργασιών. Η αναμονή γίνεται με futex
+// (χωρίς FUTEX_PRIVATE_FLAG, ώστε να λειτουργεί και σε κοινή μνήμη) και μόνο όταν κάποια πλευρά
+// έχει δηλώσει ότι περιμένει γίνεται κλήση συστήματος για αφύπνιση.
+
+// "Κουδούνι" ενός καταναλωτή που διαβάζει από πολλούς δακτυλίους: κάθε παραγωγός το χτυπά
+// όταν δημοσιεύει δεδομένα ή κλείνει τον δακτύλιό του.
+struct Doorbell {
+    std::atomic<uint32_t> sequence;     // Αυξάνεται σε κάθε χτύπημα (λέξη του futex)
+    std::atomic<uint32_t> waiting;      // Ο καταναλωτής κοιμάται ή ετοιμάζεται να κοιμηθεί
+
+    void init();
+
+    // Πριν τον τελικό έλεγχο των δακτυλίων: επιστρέφει την τιμή που θα δοθεί στη wait()
+    uint32_t prepareWait();
+
+    // Αναμονή μέχρι το επόμενο χτύπημα μετά την prepareWait()
+    void wait(uint32_t sequence);
+
+    // Ακύρωση της αναμονής όταν ο έλεγχος βρήκε δεδομένα
+    void cancelWait() { waiting.store(0); }
+
+    void ring();
+};
+
+// Κοινή κατάσταση ενός δακτυλίου. Τα δεδομένα ακολουθούν αμέσως μετά τη δομή.
+struct RingState {
+    alignas(64) std::atomic<uint64_t> head;     // Συνολικά bytes που έχει γράψει ο παραγωγός
+    alignas(64) std::atomic<uint64_t> tail;     // Συνολικά bytes που έχει διαβάσει ο καταναλωτής
+    alignas(64) std::atomic<uint32_t> space;    // Αυξάνεται όταν ελευθερώνεται χώρος (λέξη του futex)
+    std::atomic<uint32_t> producerWaiting;      // Ο παραγωγός περιμένει χώρο
+    std::atomic<uint32_t> closed;               // Ο παραγωγός ολοκλήρωσε τη ροή
+    std::atomic<uint32_t> aborted;              // Η ροή διακόπηκε επειδή τερμάτισε κάποια πλευρά
+    uint32_t capacity;                          // Μέγεθος δεδομένων (δύναμη του 2)
+};
+
+class SpscRing {
+private:
+    RingState* state;
+    char* data;
+    Doorbell* doorbell;     // Κουδούνι του καταναλωτή
+
+public:
+    // Bytes μνήμης που χρειάζεται ένας δακτύλιος με χωρητικότητα capacity (δύναμη του 2)
+    static size_t bytesFor(size_t capacity) { return sizeof(RingState) + capacity; }
+
+    // Αρχικοποίηση της κοινής κατάστασης σε μνήμη bytesFor(capacity) bytes
+    static void init(void* memory, size_t capacity);
+
+    // Πρόσβαση σε ήδη αρχικοποιημένο δακτύλιο
+    SpscRing(void* memory, Doorbell* doorbell);
+
+    // Παραγωγός: εγγραφή όλων των bytes, με αναμονή όσο ο δακτύλιος είναι γεμάτος
+    // (false αν η ροή διακόπηκε)
+    bool write(const char* bytes, size_t count);
+
+    // Παραγωγός: τέλος της ροής
+    void close();
+
+    // Καταναλωτής: ανάγνωση έως max bytes χωρίς αναμονή (0 αν είναι άδειος)
+    size_t read(char* buffer, size_t max);
+
+    // Καταναλωτής: true αν ο παραγωγός έκλεισε τη ροή και έχουν διαβαστεί όλα τα δεδομένα
+    bool finished() const;
+
+    // Καταναλωτής: true αν υπάρχουν δεδομένα ή η ροή έκλεισε (έλεγχος πριν την αναμονή στο κουδούνι)
+    bool pending() const;
+
+    // Διακοπή της ροής από τρίτο (π.χ. τη ρίζα όταν τερματίσει ένα παιδί): ο παραγωγός αποτυγχάνει
+    // στην επόμενη εγγραφή και ο καταναλωτής βλέπει τη ροή κλειστή
+    void abort();
+};
+
+// Κεφαλίδα ενός πλέγματος δακτυλίων, ώστε οι διεργασίες που το αντιστοιχίζουν να βρίσκουν τη διάταξή του
+struct RingMeshHeader {
+    uint32_t magic;
+    uint32_t numOfSplitters;
+    uint32_t numOfBuilders;
+    uint32_t capacity;          // Χωρητικότητα κάθε δακτυλίου
+};
+
+const uint32_t RING_MESH_MAGIC = 0x4c58524e;    // "LXRN"
+
+// Πλέγμα δακτυλίων numOfSplitters x numOfBuilders, ένας ανά ζεύγος splitter -> builder,
+// και ένα κουδούνι ανά builder. Διάταξη της μνήμης, σε γραμμές cache των 64 bytes:
+//     κεφαλίδα | κουδούνια των builders | δακτύλιοι (splitter 0: builders 0..M-1, splitter 1: ...)
+// Η μνήμη είναι είτε ιδιωτική (νήματα μιας διεργασίας) είτε memfd κοινό μεταξύ διεργασιών.
+class RingMesh {
+private:
+    char* memory;
+    size_t bytes;
+    size_t ringBytes;           // Bytes ανά δακτύλιο (πολλαπλάσιο των 64)
+
+    RingMesh(const RingMesh&);              // Δεν επιτρέπεται αντιγραφή
+    RingMesh& operator=(const RingMesh&);
+
+    const RingMeshHeader& header() const { return *reinterpret_cast<const RingMeshHeader*>(memory); }
+
+public:
+    RingMesh() : memory(nullptr), bytes(0), ringBytes(0) {}
+    ~RingMesh();
+
+    // Η μικρότερη δύναμη του 2 που χωρά δύο πλαίσια, ώστε ο splitter να γεμίζει
+    // το επόμενο πλαίσιο όσο ο builder καταναλώνει το προηγούμενο
+    static size_t capacityFor(size_t batchSize);
+
+    // Δημιουργία και αρχικοποίηση. Με fd >= 0 το πλέγμα τοποθετείται στο αρχείο (π.χ. memfd)
+    // ώστε να μπορούν να το αντιστοιχίσουν άλλες διεργασίες με την attach().
+    bool create(int numOfSplitters, int numOfBuilders, size_t capacity, int fd);
+
+    // Αντιστοίχιση ενός πλέγματος που έχει δημιουργήσει άλλη διεργασία
+    bool attach(int fd);
+
+    int numOfSplitters() const { return static_cast<int>(header().numOfSplitters); }
+    int numOfBuilders() const { return static_cast<int>(header().numOfBuilders); }
+
+    Doorbell* doorbell(int builder) const { return reinterpret_cast<Doorbell*>(memory + 64 + static_cast<size_t>(builder) * 64); }
+
+    // Μνήμη του δακτυλίου splitter -> builder (για τον κατασκευαστή του SpscRing)
+    void* ring(int splitter, int builder) const;
+
+    // Διακοπή όλων των ροών (βλ. SpscRing::abort)
+    void abortAll();
+};
+
+#endif // RING_HPP
@@ -0,0 +1,139 @@
+// spacesaving.cpp
+#include <cstring>
+#include <cmath>
+#include "spacesaving.hpp"
+
+SpaceSaving::SpaceSaving(size_t capacity) : capacity(capacity > 0 ? capacity : 1), size(0), slotCount(16), total(0) {
+    while (slotCount < 2 * this->capacity) slotCount *= 2;
+    counters = new Counter[this->capacity];
+    heap = new uint32_t[this->capacity];
+    slots = new uint32_t[slotCount]();
+}
+
+SpaceSaving::~SpaceSaving() {
+    for (size_t i = 0; i < size; i++) delete[] counters[i].word;
+    delete[] counters;
+    delete[] heap;
+    delete[] slots;
+}
+
+size_t SpaceSaving::capacityFor(double epsilon, size_t topK) {
+    size_t capacity = static_cast<size_t>(std::ceil(1.0 / epsilon));
+    return capacity < topK ? topK : capacity;
+}
+
+size_t SpaceSaving::findSlot(const char* word, size_t length, uint64_t hash) const {
+    size_t mask = slotCount - 1;
+    size_t pos = hash & mask;
+    while (slots[pos] != 0) {
+        const Counter& c = counters[slots[pos] - 1];
+        if (c.hash == hash && c.length == length && std::memcmp(c.word, word, length) == 0) break;
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+void SpaceSaving::removeSlot(size_t pos) {
+    size_t mask = slotCount - 1;
+    size_t next = pos;
+    while (true) {
+        next = (next + 1) & mask;
+        if (slots[next] == 0) break;
+
+        // Η εγγραφή μένει στη θέση της αν η αρχική της θέση βρίσκεται κυκλικά στο (pos, next]
+        size_t home = counters[slots[next] - 1].hash & mask;
+        bool stays = pos <= next ? (pos < home && home <= next) : (pos < home || home <= next);
+        if (stays) continue;
+
+        slots[pos] = slots[next];
+        pos = next;
+    }
+    slots[pos] = 0;
+}
+
+void SpaceSaving::swapHeap(size_t a, size_t b) {
+    uint32_t temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+    counters[heap[a]].heapIndex = static_cast<uint32_t>(a);
+    counters[heap[b]].heapIndex = static_cast<uint32_t>(b);
+}
+
+void SpaceSaving::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (counters[heap[parent]].count <= counters[heap[index]].count) break;
+        swapHeap(index, parent);
+        index = parent;
+    }
+}
+
+void SpaceSaving::siftDown(size_t index) {
+    while (true) {
+        size_t smallest = index;
+        size_t left = 2 * index + 1;
+        size_t right = left + 1;
+        if (left < size && counters[heap[left]].count < counters[heap[smallest]].count) smallest = left;
+        if (right < size && counters[heap[right]].count < counters[heap[smallest]].count) smallest = right;
+        if (smallest == index) break;
+        swapHeap(index, smallest);
+        index = smallest;
+    }
+}
+
+void SpaceSaving::storeWord(Counter& c, const char* word, size_t length, uint64_t hash) {
+    if (length + 1 > c.wordCapacity) {
+        delete[] c.word;
+        c.wordCapacity = static_cast<uint32_t>(length + 1 < 16 ? 16 : length + 1);
+        c.word = new char[c.wordCapacity];
+    }
+    std::memcpy(c.word, word, length);
+    c.word[length] = '\0';
+    c.length = static_cast<uint32_t>(length);
+    c.hash = hash;
+}
+
+void SpaceSaving::addHashed(const char* word, size_t length, uint64_t hash, long long delta) {
+    total += delta;
+
+    size_t pos = findSlot(word, length, hash);
+    if (slots[pos] != 0) {
+        // Η λέξη παρακολουθείται ήδη: το count μεγάλωσε, οπότε ο μετρητής κατεβαίνει στον σωρό
+        Counter& c = counters[slots[pos] - 1];
+        c.count += delta;
+        siftDown(c.heapIndex);
+        return;
+    }
+
+    if (size < capacity) {
+        // Ελεύθερος μετρητής
+        uint32_t index = static_cast<uint32_t>(size++);
+        Counter& c = counters[index];
+        c.word = nullptr;
+        c.wordCapacity = 0;
+        storeWord(c, word, length, hash);
+        c.count = delta;
+        c.error = 0;
+        c.heapIndex = index;
+        heap[index] = index;
+        slots[pos] = index + 1;
+        siftUp(index);
+        return;
+    }
+
+    // Αντικατάσταση του μετρητή με το μικρότερο count: η νέα λέξη κληρονομεί το count του ως σφάλμα
+    uint32_t index = heap[0];
+    Counter& c = counters[index];
+    removeSlot(findSlot(c.word, c.length, c.hash));
+    c.error = c.count;
+    c.count += delta;
+    storeWord(c, word, length, hash);
+    slots[findSlot(word, length, hash)] = index + 1;    // Η αφαίρεση μπορεί να μετακίνησε θέσεις
+    siftDown(0);
+}
+
+size_t SpaceSaving::memoryUsage() const {
+    size_t bytes = capacity * (sizeof(Counter) + sizeof(uint32_t)) + slotCount * sizeof(uint32_t);
+    for (size_t i = 0; i < size; i++) bytes += counters[i].wordCapacity;
+    return bytes;
+}
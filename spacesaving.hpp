@@ -0,0 +1,74 @@
+#ifndef SPACESAVING_HPP
+#define SPACESAVING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "wordmap.hpp"
+
+// Προσεγγιστική καταμέτρηση συχνών λέξεων (heavy hitters) με τον αλγόριθμο Space-Saving
+// (Metwally, Agrawal, El Abbadi) σε σταθερή μνήμη: το πολύ capacity μετρητές.
+//
+// Μια λέξη που δεν παρακολουθείται αντικαθιστά τον μετρητή με το μικρότερο count, κληρονομώντας
+// το count του ως σφάλμα. Για κάθε λέξη που παρακολουθείται ισχύει
+//     count - error <= πραγματικό πλήθος <= count
+// και error <= N / capacity, όπου N το άθροισμα όλων των counts που προστέθηκαν. Κάθε λέξη με
+// πραγματικό πλήθος μεγαλύτερο από N / capacity παρακολουθείται σίγουρα.
+class SpaceSaving {
+public:
+    struct Counter {
+        uint64_t hash;          // Αποθηκευμένη τιμή wordHash της λέξης
+        char* word;             // Η λέξη, τερματισμένη με '\0' (δική της μνήμη, επαναχρησιμοποιείται)
+        uint32_t length;
+        uint32_t wordCapacity;  // Μέγεθος της μνήμης της λέξης
+        uint32_t heapIndex;     // Θέση του μετρητή στον σωρό
+        long long count;        // Εκτίμηση του πλήθους (ποτέ μικρότερη από το πραγματικό)
+        long long error;        // Μέγιστη υπερεκτίμηση του count
+    };
+
+private:
+    Counter* counters;      // Οι μετρητές (size από capacity χρησιμοποιούνται)
+    size_t capacity;
+    size_t size;
+    uint32_t* heap;         // Σωρός ελαχίστου ως προς το count: δείκτες μετρητών
+    uint32_t* slots;        // Πίνακας κατακερματισμού: δείκτης μετρητή + 1 (0 = κενή θέση)
+    size_t slotCount;       // Πλήθος θέσεων (δύναμη του 2, τουλάχιστον 2 * capacity)
+    long long total;        // Άθροισμα όλων των counts που προστέθηκαν
+
+    // Θέση της λέξης στον πίνακα κατακερματισμού ή της κενής θέσης όπου θα μπει
+    size_t findSlot(const char* word, size_t length, uint64_t hash) const;
+
+    // Αφαίρεση μιας θέσης με μετακίνηση των επόμενων (backward shift), χωρίς tombstones
+    void removeSlot(size_t pos);
+
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void swapHeap(size_t a, size_t b);
+
+    // Αντιγραφή της λέξης στη μνήμη του μετρητή
+    void storeWord(Counter& c, const char* word, size_t length, uint64_t hash);
+
+    SpaceSaving(const SpaceSaving&);              // Δεν επιτρέπεται αντιγραφή
+    SpaceSaving& operator=(const SpaceSaving&);
+
+public:
+    explicit SpaceSaving(size_t capacity);
+    ~SpaceSaving();
+
+    // Πλήθος μετρητών ώστε error <= epsilon * N, και τουλάχιστον topK
+    static size_t capacityFor(double epsilon, size_t topK);
+
+    // Προσθέτει delta στο count της λέξης
+    void add(const char* word, size_t length, long long delta = 1) { addHashed(word, length, wordHash(word, length), delta); }
+
+    // Όπως η add, με ήδη υπολογισμένη την τιμή wordHash της λέξης
+    void addHashed(const char* word, size_t length, uint64_t hash, long long delta);
+
+    // Μνήμη των μετρητών, του σωρού, του πίνακα κατακερματισμού και των λέξεων σε bytes
+    size_t memoryUsage() const;
+
+    long long totalCount() const { return total; }
+    size_t get_size() const { return size; }
+    const Counter& counter(size_t index) const { return counters[index]; }
+};
+
+#endif // SPACESAVING_HPP
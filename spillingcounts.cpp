@@ -0,0 +1,254 @@
+// spillingcounts.cpp
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include "spillingcounts.hpp"
+#include "heap.hpp"
+#include "wire.hpp"
+#include "writebuffer.hpp"
+#include "trace.hpp"
+
+// Μέγεθος του buffer εγγραφής ενός run
+static const size_t RUN_BUFFER_SIZE = 256 * 1024;
+
+// Σειρά των λέξεων στα runs: λεξικογραφική ως προς τα bytes, η μικρότερη λέξη πρώτη σε κοινό πρόθεμα
+static int compareWords(const char* a, size_t aLength, const char* b, size_t bLength) {
+    int c = std::memcmp(a, b, aLength < bLength ? aLength : bLength);
+    if (c != 0) return c;
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+// Ανώνυμο προσωρινό αρχείο στο $TMPDIR (ή /tmp), που διαγράφεται αμέσως ώστε να μη μείνει μετά το τέλος
+static int createRunFile() {
+    const char* dir = std::getenv("TMPDIR");
+    if (dir == nullptr || dir[0] == '\0') dir = "/tmp";
+    char path[512];
+    snprintf(path, sizeof(path), "%s/laxen-run-XXXXXX", dir);
+    int fd = mkostemp(path, O_CLOEXEC);
+    if (fd == -1) {
+        std::perror("mkostemp");
+        return -1;
+    }
+    unlink(path);
+    return fd;
+}
+
+// Σύγκριση δεικτών εγγραφών του WordMap ως προς τη λέξη τους
+struct EntryOrder {
+    const WordMap* map;
+    bool operator()(uint32_t a, uint32_t b) const {
+        const WordMap::Entry& ea = map->entry(a);
+        const WordMap::Entry& eb = map->entry(b);
+        return compareWords(map->word(ea), ea.length, map->word(eb), eb.length) < 0;
+    }
+};
+
+// Θέση ανάγνωσης σε ένα run κατά τη συγχώνευση
+struct RunCursor {
+    int fd;
+    WireReader reader;
+    WireRecord record;      // Τρέχουσα εγγραφή (δείχνει μέσα στον buffer του reader)
+};
+
+// Σύγκριση για το σωρό των runs: στην κορυφή το run με τη μικρότερη τρέχουσα λέξη
+struct RunOrder {
+    RunCursor* cursors;
+    bool operator()(int a, int b) const {
+        const WireRecord& ra = cursors[a].record;
+        const WireRecord& rb = cursors[b].record;
+        return compareWords(ra.word, ra.length, rb.word, rb.length) < 0;
+    }
+};
+
+// Επόμενη εγγραφή ενός run. Επιστρέφει false στο τέλος του run ή σε σφάλμα (failed).
+static bool advanceRun(RunCursor& cursor, bool& failed) {
+    while (true) {
+        WireStatus status = cursor.reader.next(cursor.record);
+        if (status == WIRE_RECORD) return true;
+        if (status != WIRE_NEED_MORE) {
+            std::cerr << "Builder: invalid data in spill run" << std::endl;
+            failed = true;
+            return false;
+        }
+        ssize_t bytes_read = cursor.reader.readFrom(cursor.fd);
+        if (bytes_read > 0) continue;
+        if (bytes_read == -1) {
+            std::perror("read spill run");
+            failed = true;
+        } else if (!cursor.reader.empty()) {
+            std::cerr << "Builder: truncated spill run" << std::endl;
+            failed = true;
+        }
+        return false;
+    }
+}
+
+SpillingCounts::SpillingCounts(size_t budget, bool compact)
+    : budget(budget < SPILL_MIN_BUDGET ? SPILL_MIN_BUDGET : budget), compact(compact), spilledBytes(0), failed(false) {}
+
+SpillingCounts::~SpillingCounts() {
+    for (size_t i = 0; i < runs.get_size(); i++) close(runs[i].fd);
+}
+
+bool SpillingCounts::spill() {
+    if (map.get_size() == 0) return true;
+
+    TraceSpan span("spill");
+    int fd = createRunFile();
+    bool ok = fd != -1;
+
+    if (ok) {
+        // Ταξινόμηση των εγγραφών κατά λέξη, χωρίς μετακίνηση των ίδιων των εγγραφών
+        Vector<uint32_t> order;
+        order.reserve(map.get_size());
+        for (size_t i = 0; i < map.get_size(); i++) order.push_back(static_cast<uint32_t>(i));
+        std::sort(order.begin(), order.end(), EntryOrder{ &map });
+
+        WriteBuffer buffer(fd, RUN_BUFFER_SIZE);
+        WireWriter writer(buffer, 0);
+        ok = writer.begin();
+        for (size_t i = 0; ok && i < order.get_size(); i++) {
+            const WordMap::Entry& e = map.entry(order[i]);
+            ok = writer.word(map.word(e), e.length, 0, static_cast<uint64_t>(e.count));
+        }
+        if (ok) ok = buffer.flush();
+        if (!ok) {
+            std::perror("write spill run");
+            close(fd);
+        }
+    }
+
+    // Ο πίνακας αδειάζει και σε σφάλμα, ώστε η μνήμη να μείνει εντός του ορίου
+    map.clear();
+    if (!ok) {
+        failed = true;
+        return false;
+    }
+    spilledBytes += lseek(fd, 0, SEEK_CUR);
+    Run run = { fd, 0 };
+    runs.push_back(run);
+
+    // Τα επίπεδα δεν αυξάνονται κατά μήκος του runs, οπότε τα runs του ίδιου επιπέδου είναι στο τέλος
+    span.end();
+    while (runs.get_size() >= SPILL_MAX_FAN_IN) {
+        int level = runs[runs.get_size() - 1].level;
+        if (runs[runs.get_size() - SPILL_MAX_FAN_IN].level != level) break;
+        if (!mergeTail(SPILL_MAX_FAN_IN, level + 1)) return false;
+    }
+    return true;
+}
+
+bool SpillingCounts::mergeRuns(size_t first, size_t count, MergeSink* sink, int outFd) {
+    TraceSpan span("merge runs");
+    RunCursor* cursors = new RunCursor[count];
+    Heap<int, RunOrder> heap(RunOrder{ cursors });
+    for (size_t i = 0; i < count; i++) {
+        cursors[i].fd = runs[first + i].fd;
+        lseek(cursors[i].fd, 0, SEEK_SET);
+        if (advanceRun(cursors[i], failed)) heap.push(static_cast<int>(i));
+    }
+
+    WriteBuffer* outBuffer = nullptr;
+    WireWriter* outWriter = nullptr;
+    bool outOk = true;
+    if (outFd >= 0) {
+        outBuffer = new WriteBuffer(outFd, RUN_BUFFER_SIZE);
+        outWriter = new WireWriter(*outBuffer, 0);
+        outOk = outWriter->begin();
+    }
+
+    // Η τρέχουσα λέξη αντιγράφεται, αφού η επόμενη ανάγνωση του run της μπορεί να μετακινήσει τον buffer
+    size_t currentCapacity = 256;
+    char* current = new char[currentCapacity];
+    while (!heap.empty()) {
+        const WireRecord& first = cursors[heap.top()].record;
+        size_t length = first.length;
+        if (length > currentCapacity) {
+            delete[] current;
+            while (currentCapacity < length) currentCapacity *= 2;
+            current = new char[currentCapacity];
+        }
+        std::memcpy(current, first.word, length);
+
+        // Άθροιση των counts της λέξης από όλα τα runs
+        long long total = 0;
+        while (!heap.empty()) {
+            int i = heap.top();
+            const WireRecord& record = cursors[i].record;
+            if (compareWords(record.word, record.length, current, length) != 0) break;
+            total += static_cast<long long>(record.count);
+            if (advanceRun(cursors[i], failed)) {
+                heap.replaceTop(i);
+            } else {
+                heap.pop();
+            }
+        }
+
+        if (sink != nullptr) sink->word(current, length, total);
+        if (outWriter != nullptr && outOk) outOk = outWriter->word(current, length, 0, static_cast<uint64_t>(total));
+    }
+    delete[] current;
+    delete[] cursors;
+
+    if (outBuffer != nullptr) {
+        if (outOk) outOk = outBuffer->flush();
+        if (!outOk) std::perror("write spill run");
+        delete outWriter;
+        delete outBuffer;
+    }
+    return outOk && !failed;
+}
+
+bool SpillingCounts::mergeTail(size_t count, int level) {
+    int fd = createRunFile();
+    size_t first = runs.get_size() - count;
+    if (fd == -1 || !mergeRuns(first, count, nullptr, fd)) {
+        // Τα αρχικά runs μένουν, αλλά χωρίς τη συγχώνευση τα αρχεία θα αυξάνονταν χωρίς όριο
+        if (fd != -1) close(fd);
+        failed = true;
+        return false;
+    }
+
+    // Τα runs που συγχωνεύτηκαν έχουν ήδη διαγραφεί, οπότε το κλείσιμο ελευθερώνει και το χώρο τους
+    while (runs.get_size() > first) {
+        close(runs[runs.get_size() - 1].fd);
+        runs.pop_back();
+    }
+    spilledBytes += lseek(fd, 0, SEEK_CUR);
+    Run run = { fd, level };
+    runs.push_back(run);
+    return true;
+}
+
+bool SpillingCounts::merge(MergeSink& sink) {
+    if (!spill()) return false;
+
+    // Περάσματα με τα μικρότερα runs (στο τέλος) μέχρι να μείνουν όσα χωρούν σε μία συγχώνευση
+    while (runs.get_size() > SPILL_MAX_FAN_IN) {
+        if (!mergeTail(SPILL_MAX_FAN_IN, runs[runs.get_size() - SPILL_MAX_FAN_IN].level + 1)) return false;
+    }
+
+    // Με compact το αποτέλεσμα γράφεται σε νέο run που αντικαθιστά όλα τα προηγούμενα
+    int mergedFd = -1;
+    if (compact && runs.get_size() > 1) mergedFd = createRunFile();
+    bool ok = mergeRuns(0, runs.get_size(), &sink, mergedFd);
+
+    if (mergedFd != -1) {
+        if (ok) {
+            int level = runs[0].level + 1;
+            for (size_t i = 0; i < runs.get_size(); i++) close(runs[i].fd);
+            runs.clear();
+            Run run = { mergedFd, level };
+            runs.push_back(run);
+            spilledBytes += lseek(mergedFd, 0, SEEK_CUR);
+        } else {
+            // Τα αρχικά runs μένουν και χρησιμοποιούνται στην επόμενη συγχώνευση
+            close(mergedFd);
+        }
+    }
+    return !failed;
+}
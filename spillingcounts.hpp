@@ -0,0 +1,91 @@
+#ifndef SPILLINGCOUNTS_HPP
+#define SPILLINGCOUNTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "vector.hpp"
+#include "wordmap.hpp"
+
+// Παραλήπτης των λέξεων της συγχώνευσης: κάθε λέξη μία φορά, σε αύξουσα σειρά, με το συνολικό count της
+class MergeSink {
+public:
+    virtual ~MergeSink() {}
+
+    virtual void word(const char* word, size_t length, long long count) = 0;
+};
+
+// Ακριβής καταμέτρηση με όριο μνήμης (--mem-budget). Οι λέξεις μετρώνται σε WordMap και όταν η μνήμη
+// του ξεπεράσει το όριο, τα counts γράφονται ταξινομημένα κατά λέξη σε ένα run (ανώνυμο προσωρινό
+// αρχείο, με το πρωτόκολλο του wire.hpp) και ο πίνακας αδειάζει. Μια λέξη μπορεί να εμφανίζεται σε
+// περισσότερα runs: τα συνολικά counts προκύπτουν από συγχώνευση (k-way merge) όλων των runs, που
+// διαβάζονται σειριακά με έναν buffer ανά run.
+//
+// Μια συγχώνευση διαβάζει το πολύ SPILL_MAX_FAN_IN runs. Όταν συσσωρευτούν τόσα runs του ίδιου
+// επιπέδου, συγχωνεύονται σε ένα run του επόμενου επιπέδου, οπότε τα ανοιχτά αρχεία και οι buffers
+// ανάγνωσης μένουν φραγμένα (λογαριθμικά ως προς το πλήθος των εγγραφών σε run) και κάθε count
+// ξαναγράφεται μία φορά ανά επίπεδο.
+const size_t SPILL_MAX_FAN_IN = 64;         // Μέγιστο πλήθος runs ανά συγχώνευση
+const size_t SPILL_MIN_BUDGET = 64 * 1024;  // Μικρότερο όριο μνήμης (ένας buffer ανάγνωσης run)
+
+class SpillingCounts {
+private:
+    struct Run {
+        int fd;
+        int level;          // 0 για run από τον πίνακα, L + 1 για συγχώνευση runs επιπέδου L
+    };
+
+    WordMap map;            // Counts που δεν έχουν γραφτεί ακόμα σε run
+    WordMap results;        // Οι λέξεις που επιλέχθηκαν από την τελευταία συγχώνευση
+    size_t budget;          // Όριο μνήμης του map σε bytes
+    bool compact;           // Μετά από κάθε συγχώνευση τα runs αντικαθίστανται από το αποτέλεσμά της
+    Vector<Run> runs;       // Τα runs, με μη αύξοντα επίπεδα
+    long long spilledBytes; // Συνολικό μέγεθος των runs που γράφτηκαν
+    bool failed;            // Σφάλμα εισόδου/εξόδου σε κάποιο run
+
+    // Εγγραφή των counts του map σε νέο run και άδειασμα του map
+    bool spill();
+
+    // Συγχώνευση (k-way merge) των runs [first, first + count). Κάθε λέξη παραδίδεται μία φορά στο sink
+    // (αν δεν είναι nullptr) και γράφεται στο run outFd (αν >= 0). Επιστρέφει false σε σφάλμα.
+    bool mergeRuns(size_t first, size_t count, MergeSink* sink, int outFd);
+
+    // Αντικατάσταση των count τελευταίων runs από τη συγχώνευσή τους σε ένα run επιπέδου level
+    bool mergeTail(size_t count, int level);
+
+    SpillingCounts(const SpillingCounts&);              // Δεν επιτρέπεται αντιγραφή
+    SpillingCounts& operator=(const SpillingCounts&);
+
+public:
+    // Με compact (--follow, όπου η συγχώνευση γίνεται σε κάθε εποχή) τα runs δεν πολλαπλασιάζονται.
+    // Ένα budget κάτω από SPILL_MIN_BUDGET αυξάνεται σε αυτό, ώστε ένα run να μην έχει λίγες μόνο λέξεις.
+    SpillingCounts(size_t budget, bool compact);
+    ~SpillingCounts();
+
+    // Προσθέτει delta στο count της λέξης
+    void add(const char* word, size_t length, long long delta = 1) { addHashed(word, length, wordHash(word, length), delta); }
+
+    // Όπως η add, με ήδη υπολογισμένη την τιμή wordHash της λέξης
+    void addHashed(const char* word, size_t length, uint64_t hash, long long delta) {
+        map.addHashed(word, length, hash, delta);
+        if (map.memoryUsage() > budget) spill();
+    }
+
+    // Γράφει όσα counts είναι στη μνήμη σε run και παραδίδει στο sink όλες τις λέξεις των runs
+    bool merge(MergeSink& sink);
+
+    // Λέξεις και μνήμη του πίνακα που δεν έχει γραφτεί ακόμα σε run
+    size_t get_size() const { return map.get_size(); }
+    size_t memoryUsage() const { return map.memoryUsage(); }
+
+    size_t numOfRuns() const { return runs.get_size(); }
+    long long get_spilledBytes() const { return spilledBytes; }
+    bool ok() const { return !failed; }
+
+    // Τα counts που δεν έχουν γραφτεί σε run (όλα, αν δεν έχει γίνει καμία εγγραφή)
+    const WordMap& inMemory() const { return map; }
+
+    // Πίνακας για τις λέξεις που επιλέγονται από μια συγχώνευση, ώστε να ζουν όσο τα counts
+    WordMap& resultTable() { return results; }
+};
+
+#endif // SPILLINGCOUNTS_HPP
@@ -4,8 +4,19 @@
 #include <unistd.h>
 #include <cstring>
 #include <cstdlib>
-#include <sys/times.h> 
+#include <sys/resource.h>
+#include <climits>
+#include <cerrno>
 #include "vector.hpp"
+#include "reader.hpp"
+#include "wire.hpp"
+#include "exclusionset.hpp"
+#include "tokenizer.hpp"
+#include "splittercore.hpp"
+#include "ring.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+#include "chunkqueue.hpp"
 
 // Δομή Παραμέτρων
 struct Parameters {
@@ -13,142 +24,143 @@ struct Parameters {
     char inputFile[256];
     char exclusionFile[256];
     int numOfBuilders;
-    int startLine;
-    int endLine;
+    long long startByte;    // Πρώτο byte του τμήματος
+    long long endByte;      // Ένα μετά το τελευταίο byte του τμήματος
     int idSplitter;
+    char readerBackend[16]; // Backend ανάγνωσης εισόδου (mmap, pread, uring)
+    int batchSize;          // Μέγεθος πλαισίου εξόδου προς κάθε builder σε bytes
+    bool sendHashes;        // Αποστολή της τιμής κατακερματισμού μαζί με κάθε λέξη
+    long long combineBytes; // Όριο μνήμης του τοπικού combiner σε bytes (0 = χωρίς combiner)
+    int exclusionFd;        // fd με το έτοιμο image του συνόλου εξαιρέσεων από τη ρίζα (-1 = ανάγνωση του αρχείου)
+    char tokenizerKernel[16];   // Πυρήνας κατηγοριοποίησης bytes (auto, scalar, sse2, avx2)
+    int ringFd;             // fd του πλέγματος δακτυλίων κοινής μνήμης από τη ρίζα (-1 = named pipes)
+    int controlFd;          // pipe με τα νέα τμήματα της εισόδου από τη ρίζα (--follow, -1 = μόνο το αρχικό τμήμα)
+    char traceFile[256];    // Αρχείο trace της ρίζας για τις φάσεις του splitter (--trace, κενό = χωρίς)
+    int chunkFd;            // fd της κοινής ουράς τμημάτων από τη ρίζα (--chunk, -1 = μόνο το [startByte, endByte))
 };
 
+
 // Συνάρτηση για ανάλυση των ορισμάτων
 Parameters parseArguments(int argc, char* argv[]);
 
-// Συνάρτηση για την έυρεση της πίνακα λέξεων εξαιρέσεων
-Vector<char*> vectorExclusionWords(const char* exclusionFile);
-
-// Συνάρτηση για την επεξεργασία λέξεων (καθαρισμός και έλεγχος)
-char* cleanWord(const char* word, Vector<char*>& exclusionList);
-
-// Συνάρτηση κατακερματισμού για μια συμβολοσειρά
-unsigned int hashFunction(const char* key, int size);
+// Ανάγνωση του επόμενου τμήματος από το pipe ελέγχου. false όταν η ρίζα κλείσει το pipe.
+bool readRange(int fd, RangeMessage& range);
 
 
 int main(int argc, char *argv[]) {
-    struct tms tb1, tb2;
-
-    // Αριθμός ticks ανά δευτερόλεπτο
-    double ticspersec = static_cast<double>(sysconf(_SC_CLK_TCK));
-
     // Μέτρηση αρχικού χρόνου
-    double t1 = static_cast<double>(times(&tb1));
+    double t1 = clockSeconds(CLOCK_MONOTONIC);
+    double c1 = clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+    ProcessStats stats;
 
     // Ανάλυση ορισμάτων
     Parameters params = parseArguments(argc, argv);
 
-    // Δημιουργία λίστας εξαιρέσεων από το αρχείο εξαιρέσεων
-    Vector<char*> exclusionList = vectorExclusionWords(params.exclusionFile);
+    // Καταγραφή των φάσεων, που προστίθενται στο αρχείο trace στο τέλος
+    TraceBuffer* trace = nullptr;
+    if (params.traceFile[0] != '\0') {
+        char label[32];
+        snprintf(label, sizeof(label), "splitter %d", params.idSplitter);
+        trace = new TraceBuffer(label, true);
+        trace->activate();
+    }
+
+    // Σύνολο εξαιρέσεων: το image που έχει ήδη φτιάξει η ρίζα, αλλιώς ανάγνωση του αρχείου εξαιρέσεων
+    ExclusionSet exclusionSet;
+    {
+        TraceSpan span("load exclusion set");
+        if (params.exclusionFd < 0 || !exclusionSet.mapImage(params.exclusionFd)) {
+            exclusionSet.loadFile(params.exclusionFile);
+        }
+        if (params.exclusionFd >= 0) close(params.exclusionFd);
+    }
 
-    // Δημιουργία λίστας file descriptors για named pipes
-    Vector<int> builderPipeDescriptors;
-    for (int j = 0; j < params.numOfBuilders; j++) { 
+    // Δημιουργία λίστας buffers εξόδου για τα named pipes ή για τους δακτυλίους κοινής μνήμης
+    Vector<BuilderOutput*> builderOutputs;
+    Vector<SpscRing*> rings;
+    RingMesh mesh;
+    unsigned wireFlags = params.sendHashes ? WIRE_HASHES : 0;
+    if (params.ringFd >= 0) {
+        bool attached = mesh.attach(params.ringFd);
+        close(params.ringFd);
+        if (!attached || mesh.numOfBuilders() != params.numOfBuilders || params.idSplitter >= mesh.numOfSplitters()) {
+            std::cerr << "Splitter " << params.idSplitter << ": unusable ring mesh" << std::endl;
+            return 2;
+        }
+        for (int j = 0; j < params.numOfBuilders; j++) {
+            SpscRing* ring = new SpscRing(mesh.ring(params.idSplitter, j), mesh.doorbell(j));
+            rings.push_back(ring);
+            builderOutputs.push_back(new BuilderOutput(ring, params.batchSize, wireFlags));
+        }
+    }
+    for (int j = 0; params.ringFd < 0 && j < params.numOfBuilders; j++) { 
         // Δημιουργία του ονόματος του named pipe
         char fifo_path[50];
         sprintf(fifo_path, "fifo_splitter%d_builder%d", params.idSplitter, j);
 
-        // Άνοιγμα του named pipe για εγγραφή
+        // Άνοιγμα του named pipe για εγγραφή (περιμένει μέχρι να το ανοίξει ο builder)
+        TraceSpan span("open fifo");
         int fd = open(fifo_path, O_WRONLY);
         if (fd == -1) {     // Έλεγχος αποτυχίας ανοίγματος
             std::perror("open");
             return 2;
         }
-
-        builderPipeDescriptors.push_back(fd);   // Προσθήκη του file descriptor στον vector
-    }
-
-    
-
-    // Άνοιγμα του αρχείου εισόδου για ανάγνωση
-    int file_fd = open(params.inputFile, O_RDONLY);
-    if (file_fd == -1) {    // Έλεγχος αποτυχίας ανοίγματος
-        std::perror("open input file");
-        for (size_t i = 0; i < builderPipeDescriptors.get_size(); i++) close(builderPipeDescriptors[i]);
-        return 2;
+        builderOutputs.push_back(new BuilderOutput(fd, params.batchSize, wireFlags));   // Προσθήκη της εξόδου στον vector
     }
 
-    // Μετατροπή του file descriptor σε FILE* για χρήση με fgets
-    FILE* file = fdopen(file_fd, "r");
-    if (file == NULL) {     // Έλεγχος αποτυχίας μετατροπής
-        std::perror("fdopen");
-        for (size_t i = 0; i < builderPipeDescriptors.get_size(); i++) close(builderPipeDescriptors[i]);
-        close(file_fd);
-        return 2;
+    // Με --chunk τα τμήματα διεκδικούνται από την κοινή ουρά της ρίζας αντί για το [startByte, endByte)
+    ChunkQueue chunkQueue;
+    if (params.chunkFd >= 0) {
+        bool attached = chunkQueue.attach(params.chunkFd);
+        close(params.chunkFd);
+        if (!attached) {
+            std::cerr << "Splitter " << params.idSplitter << ": unusable chunk queue" << std::endl;
+            return 2;
+        }
     }
 
-    const size_t buffer_size = 1024;
-    char buffer[buffer_size];
-
-    int  line = 0;  // Μετρητής γραμμών
-    while (fgets(buffer, buffer_size, file) != NULL) {  // Ανάγνωση γραμμών από το αρχείο
-        if (line >= params.startLine && line <= params.endLine) {   // Επεξεργασία μόνο των γραμμών εντός του εύρους
-            // Διαχωρισμός της γραμμής σε λέξεις
-            char* token = strtok(buffer, " \t\n");
-            while (token != NULL) {
-                // Καθαρισμός της λέξης από σημεία στίξης και εξαιρέσεις
-                char* cleanToken = cleanWord(token, exclusionList);
-
-                // Έλεγχος αν το cleanToken είναι nullptr ή κενή αλυσίδα
-                if (cleanToken == nullptr) {
-                    token = strtok(NULL, " \t\n"); // Επόμενη λέξη
-                    continue;
-                }
-                
-                // Υπολογισμός του builder που θα λάβει τη λέξη
-                int builderIndex = hashFunction(cleanToken, params.numOfBuilders);
-                if (builderIndex < 0 || builderIndex >= params.numOfBuilders) {     // Έλεγχος εγκυρότητας του index
-                    std::perror("hashFunction");
-                    delete[] cleanToken;
-                    return 2;
-                } 
-
-                // Εγγραφή της λέξης στο αντίστοιχο pipe
-                ssize_t bytes_written = write(builderPipeDescriptors[builderIndex], cleanToken, strlen(cleanToken));
-                if (bytes_written == -1) {      // Έλεγχος αποτυχίας εγγραφής
-                    std::perror("write");
-                    fclose(file);
-                    for (size_t i = 0; i < builderPipeDescriptors.get_size(); i++) close(builderPipeDescriptors[i]);
-                    return 2;
-                }
-
-                // Γράψιμο νέας γραμμής για διαχωρισμό λέξεων
-                write(builderPipeDescriptors[builderIndex], "\n", 1);
-
-                // Απελευθέρωση της μνήμης που δεσμεύτηκε από το cleanWord
-                delete[] cleanToken;
-
-                token = strtok(NULL, " \t\n"); // Επόμενη λέξη
-            }
+    // Ανάγνωση του τμήματος και αποστολή των λέξεων στους builders
+    SplitterOptions options = { params.inputFile, params.startByte, params.endByte, params.readerBackend, params.tokenizerKernel, params.combineBytes,
+                                params.chunkFd >= 0 ? &chunkQueue : nullptr };
+    bool ok;
+    if (params.controlFd < 0) {
+        ok = runSplitter(options, exclusionSet, builderOutputs, stats);
+    } else {
+        // --follow: το αρχικό τμήμα είναι η εποχή 1 και κάθε τμήμα που στέλνει η ρίζα η επόμενη.
+        // Οι ροές μένουν ανοιχτές μέχρι να κλείσει η ρίζα το pipe ελέγχου.
+        uint64_t epoch = 1;
+        ok = startSplitter(options, builderOutputs) && splitRange(options, exclusionSet, builderOutputs, stats) &&
+             markEpoch(epoch, builderOutputs);
+        RangeMessage range;
+        while (ok && readRange(params.controlFd, range)) {
+            options.startByte = range.startByte;
+            options.endByte = range.endByte;
+            ok = splitRange(options, exclusionSet, builderOutputs, stats) && markEpoch(++epoch, builderOutputs);
         }
-        if (line >= params.endLine)  break;     // Τερματισμός όταν περάσουμε το endLine
-        line ++;
+        close(params.controlFd);
+        if (!closeOutputs(builderOutputs)) ok = false;
     }
-
-    // Κλείνει το αρχείο εισόδου
-    fclose(file); 
-    // Κλείσιμο όλων των named pipes προς τους builders
-    for (size_t i = 0; i < builderPipeDescriptors.get_size(); i++) close(builderPipeDescriptors[i]);
-    // Απελευθέρωση της μνήμης για τη λίστα εξαιρέσεων
-    for (size_t i = 0; i < exclusionList.get_size(); ++i) {
-        delete[] exclusionList[i];
+    collectOutputStats(builderOutputs, stats);
+    for (size_t i = 0; i < builderOutputs.get_size(); i++) delete builderOutputs[i];
+    for (size_t i = 0; i < rings.get_size(); i++) delete rings[i];
+    if (!ok) return 2;
+
+    // Μέτρηση τελικού χρόνου και CPU χρόνου
+    stats.realTime = clockSeconds(CLOCK_MONOTONIC) - t1;
+    stats.cpuTime = clockSeconds(CLOCK_PROCESS_CPUTIME_ID) - c1;
+    collectUsage(stats, RUSAGE_SELF);
+
+    if (trace != nullptr) {
+        currentTrace = nullptr;
+        appendTraceFile(params.traceFile, *trace);
+        delete trace;
     }
 
-    // Μέτρηση τελικού χρόνου
-    double t2 = static_cast<double>(times(&tb2));
-
-    // Υπολογισμός CPU χρόνου
-    double cpu_time = static_cast<double>((tb2.tms_utime + tb2.tms_stime) - (tb1.tms_utime + tb1.tms_stime));
-
-    // Ειδοποίηση της ρίζας ότι ο splitter ολοκλήρωσε την εργασία του
-    char write_path[70];
-    snprintf(write_path, sizeof(write_path), "SplitterDone-%d-%f-%f", params.idSplitter, (t2 - t1) / ticspersec, cpu_time / ticspersec); 
-    if (write(params.pipe_write_fd, write_path, strlen(write_path) + 1) < 0) {
+    // Ειδοποίηση της ρίζας ότι ο splitter ολοκλήρωσε την εργασία του, με τους μετρητές του.
+    // Το μήνυμα χωράει σε PIPE_BUF, ώστε να γράφεται ατομικά.
+    char write_path[PIPE_BUF];
+    size_t messageLength = formatDoneMessage(write_path, sizeof(write_path), "SplitterDone", params.idSplitter, stats);
+    if (write(params.pipe_write_fd, write_path, messageLength + 1) < 0) {
         std::perror("Error writing SplitterDone message to pipe.");
         return 2;
     }
@@ -158,7 +170,7 @@ int main(int argc, char *argv[]) {
 }
 
 Parameters parseArguments(int argc, char* argv[]) {
-    Parameters params = {-1, "", "", 0, -1, -1, -1};
+    Parameters params = {-1, "", "", 0, -1, -1, -1, "pread", 64 * 1024, false, 0, -1, "auto", -1, -1, "", -1};
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
@@ -178,108 +190,67 @@ Parameters parseArguments(int argc, char* argv[]) {
         } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
             params.numOfBuilders = std::atoi(argv[i + 1]);
             i++;
-        } else if (strcmp(argv[i], "-sL") == 0 && i + 1 < argc) { 
-            params.startLine = std::atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            strncpy(params.readerBackend, argv[i + 1], sizeof(params.readerBackend) - 1);
+            params.readerBackend[sizeof(params.readerBackend) - 1] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "-H") == 0) {
+            params.sendHashes = true;
+        } else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) {
+            strncpy(params.tokenizerKernel, argv[i + 1], sizeof(params.tokenizerKernel) - 1);
+            params.tokenizerKernel[sizeof(params.tokenizerKernel) - 1] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            params.exclusionFd = std::atoi(argv[i + 1]);
             i++;
-        } else if (strcmp(argv[i], "-eL") == 0 && i + 1 < argc) { 
-            params.endLine = std::atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-R") == 0 && i + 1 < argc) {
+            params.ringFd = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-F") == 0 && i + 1 < argc) {
+            params.controlFd = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-Q") == 0 && i + 1 < argc) {
+            params.chunkFd = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-tr") == 0 && i + 1 < argc) {
+            strncpy(params.traceFile, argv[i + 1], 255);
+            params.traceFile[255] = '\0';
+            i++;
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            params.combineBytes = std::strtoll(argv[i + 1], NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            params.batchSize = std::atoi(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "-sB") == 0 && i + 1 < argc) { 
+            params.startByte = std::strtoll(argv[i + 1], NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "-eB") == 0 && i + 1 < argc) { 
+            params.endByte = std::strtoll(argv[i + 1], NULL, 10);
             i++;
         }
     }
 
     if (strlen(params.inputFile) == 0 || strlen(params.exclusionFile) == 0 || params.numOfBuilders <= 0 ||
-        params.startLine < 0 || params.endLine < params.startLine || params.idSplitter < 0) {
-        std::cerr << "Usage: ./splitter -i inputfile -e exclusionfile -m numOfBuilders -sL startLine -eL endLine" << std::endl;
+        params.startByte < 0 || params.endByte < params.startByte || params.idSplitter < 0 || !isReaderBackend(params.readerBackend) || params.batchSize < PIPE_BUF || params.combineBytes < 0 || !isTokenizerKernel(params.tokenizerKernel)) {
+        std::cerr << "Usage: ./splitter -i inputfile -e exclusionfile -m numOfBuilders -sB startByte -eB endByte [-r mmap|pread|uring] [-b batchSize] [-H] [-c combineBytes] [-x exclusionImageFd] [-T auto|scalar|sse2|avx2] [-R ringMeshFd] [-F controlFd] [-Q chunkQueueFd] [-tr traceFile]" << std::endl;
         std::exit(1);
     }
 
     return params;
 }
 
-Vector<char*> vectorExclusionWords(const char* exclusionFile) {
-    Vector<char*> exclusionWords;
-    // Άνοιγμα του αρχείου εξαιρέσεων με open
-    int file_fd = open(exclusionFile, O_RDONLY);
-    if (file_fd == -1) {  // Έλεγχος αποτυχίας ανοίγματος
-        std::perror("open exclusion file");
-        return exclusionWords;
-    }
-
-    // Μετατροπή του file descriptor σε FILE* για χρήση με fgets
-    FILE* file = fdopen(file_fd, "r");
-    if (file == NULL) {  // Έλεγχος αποτυχίας μετατροπής
-        std::perror("fdopen");
-        close(file_fd);
-        return exclusionWords;
-    }
-
-    const size_t buffer_size = 256;
-    char buffer[buffer_size];
-
-    // Ανάγνωση του αρχείου γραμμή προς γραμμή
-    while (fgets(buffer, buffer_size, file) != NULL) {
-        // Αφαίρεση του χαρακτήρα νέας γραμμής στο τέλος (αν υπάρχει)
-        size_t len = strlen(buffer);
-        if (len > 0 && buffer[len - 1] == '\n') {
-            buffer[len - 1] = '\0';
-        }
-
-        // Διαχωρισμός της γραμμής σε λέξεις
-        char* token = strtok(buffer, " \t");
-        while (token != NULL) {
-            // Δημιουργία αντιγράφου της λέξης
-            char* word = new char[strlen(token) + 1];
-            std::strcpy(word, token);
-
-            exclusionWords.push_back(word);  // Προσθήκη της λέξης στον Vector
-
-            token = strtok(NULL, " \t");    // Επόμενο toke
+bool readRange(int fd, RangeMessage& range) {
+    while (true) {
+        ssize_t bytes_read = read(fd, &range, sizeof(range));
+        if (bytes_read == static_cast<ssize_t>(sizeof(range))) {
+            if (range.startByte >= 0 && range.endByte >= range.startByte) return true;
+            std::cerr << "Splitter: invalid range from root" << std::endl;
+            return false;
         }
+        if (bytes_read == -1 && errno == EINTR) continue;
+        if (bytes_read == -1) std::perror("read control pipe");
+        else if (bytes_read > 0) std::cerr << "Splitter: truncated range from root" << std::endl;
+        return false;
     }
-
-    fclose(file); // Κλείσιμο του αρχείου (κλείνει και το file_fd)
-    return exclusionWords;
-}
-
-char* cleanWord(const char* word, Vector<char*>& exclusionList) {
-    // Υπολογισμός μήκους της λέξης
-    int length = std::strlen(word);
-    
-    // Δημιουργία buffer για την καθαρισμένη λέξη
-    char* cleanedWord = new char[length + 1];
-    int index = 0;
-
-    // Αφαίρεση σημείων στίξης, συμβόλων και ψηφίων
-    for (int i = 0; i < length; ++i) {
-        if (std::isalpha(static_cast<unsigned char>(word[i]))) {        // Ελέγχει αν ο χαρακτήρας είναι γράμμα
-            cleanedWord[index++] = std::tolower(static_cast<unsigned char>(word[i]));  // Μετατροπή σε πεζά
-        }
-    }
-    cleanedWord[index] = '\0';      // Τερματισμός της καθαρισμένης συμβολοσειράς
-
-    // Έλεγχος αν η καθαρισμένη λέξη είναι κενή ή αν εχει ένα χαρακτήρα
-    if (index == 0 || index == 1) {
-        delete[] cleanedWord;       // Απελευθέρωση μνήμης αν δεν υπάρχει καθαρισμένη λέξη
-        return nullptr;
-    }
-
-    // Έλεγχος αν η καθαρισμένη λέξη βρίσκεται στη λίστα αποκλεισμού
-    for (size_t i = 0; i < exclusionList.get_size(); ++i) {
-        if (std::strcmp(cleanedWord, exclusionList[i]) == 0) {      // Σύγκριση με κάθε λέξη της exclusion list
-            delete[] cleanedWord;       // Αν βρεθεί στη λίστα, απελευθέρωση μνήμης
-            return nullptr;
-        }
-    }
-
-    // Επιστροφή της καθαρισμένης λέξης
-    return cleanedWord;
-}
-
-unsigned int hashFunction(const char* key, int size) {
-    unsigned int hash = 5381;
-    int c;
-    while ((c = *key++)) {
-        hash = ((hash << 5) + hash) + c; // hash * 33 + c
-    }
-    return hash % size;
 }
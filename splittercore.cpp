@@ -0,0 +1,167 @@
+// splittercore.cpp
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "splittercore.hpp"
+#include "reader.hpp"
+#include "tokenizer.hpp"
+#include "trace.hpp"
+#include "chunkqueue.hpp"
+
+bool runSplitter(const SplitterOptions& options, const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs,
+                 ProcessStats& stats) {
+    bool ok = startSplitter(options, builderOutputs) && splitRange(options, exclusionSet, builderOutputs, stats);
+    // Οι έξοδοι κλείνουν και σε σφάλμα, ώστε οι builders να μην περιμένουν
+    if (!closeOutputs(builderOutputs)) ok = false;
+    return ok;
+}
+
+bool startSplitter(const SplitterOptions& options, Vector<BuilderOutput*>& builderOutputs) {
+    for (size_t j = 0; j < builderOutputs.get_size(); j++) {
+        BuilderOutput* output = builderOutputs[j];
+        if (options.combineBytes > 0) {
+            // Το όριο μνήμης μοιράζεται ισόποσα στους combiners των builders
+            output->combiner = new WordMap();
+            output->combinerLimit = options.combineBytes / builderOutputs.get_size();
+        }
+        if (!output->writer.begin()) return false;  // Κεφαλίδα της ροής
+    }
+    return true;
+}
+
+// Ανάγνωση του τμήματος [startByte, endByte) του ανοιχτού αρχείου και αποστολή των λέξεών του
+static bool splitChunk(int file_fd, long long startByte, long long endByte, const SplitterOptions& options,
+                       const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs, ProcessStats& stats) {
+    // Δημιουργία του reader για το τμήμα [startByte, endByte) με το επιλεγμένο backend
+    InputReader* reader = createReader(options.readerBackend, file_fd, startByte, endByte);
+
+    // Τμηματοποίηση και καθαρισμός των blocks με τον πυρήνα που υποστηρίζει η CPU
+    Tokenizer tokenizer(selectTokenizerKernel(options.tokenizerKernel));
+    WordRouter router = { exclusionSet, builderOutputs, stats };
+    bool ok = true;
+    const char* data;
+    size_t length;
+    while (ok) {
+        bool more;
+        {
+            TraceSpan span("read");
+            more = reader->next(data, length);
+        }
+        if (!more) break;
+
+        TraceSpan span("tokenize");
+        stats.bytesRead += static_cast<long long>(length);
+        // Μέτρηση γραμμών με memchr, που διασχίζει το block πολύ γρηγορότερα από τον tokenizer
+        const char* end = data + length;
+        for (const char* p = data; (p = static_cast<const char*>(memchr(p, '\n', end - p))) != nullptr; p++) {
+            stats.linesRead++;
+        }
+        ok = tokenizer.feed(data, length, router);
+    }
+    // Η τελευταία λέξη του τμήματος
+    if (ok) ok = tokenizer.finish(router);
+    if (reader->failed()) ok = false;
+    stats.readCalls += static_cast<long long>(reader->get_readCalls());
+    stats.tooShort += static_cast<long long>(tokenizer.get_shortWords());
+    delete reader;
+    return ok;
+}
+
+bool splitRange(const SplitterOptions& options, const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs,
+                ProcessStats& stats) {
+    // Άνοιγμα του αρχείου εισόδου για ανάγνωση
+    int file_fd = open(options.inputFile, O_RDONLY);
+    if (file_fd == -1) {    // Έλεγχος αποτυχίας ανοίγματος
+        std::perror("open input file");
+        return false;
+    }
+
+    // Το σταθερό τμήμα ή τα τμήματα της ουράς, μέχρι να μοιραστούν όλα
+    bool ok;
+    if (options.chunks == nullptr) {
+        ok = splitChunk(file_fd, options.startByte, options.endByte, options, exclusionSet, builderOutputs, stats);
+    } else {
+        ok = true;
+        long long start, end;
+        while (ok && options.chunks->claim(file_fd, start, end)) {
+            stats.chunks++;
+            ok = splitChunk(file_fd, start, end, options, exclusionSet, builderOutputs, stats);
+        }
+    }
+
+    // Κλείνει το αρχείο εισόδου
+    close(file_fd);
+
+    // Αποστολή των τοπικών counts
+    if (options.combineBytes > 0) {
+        TraceSpan span("flush combiners");
+        for (size_t i = 0; ok && i < builderOutputs.get_size(); i++) {
+            if (builderOutputs[i]->combiner != nullptr && !flushCombiner(*builderOutputs[i])) ok = false;
+        }
+    }
+    return ok;
+}
+
+bool markEpoch(uint64_t epoch, Vector<BuilderOutput*>& builderOutputs) {
+    for (size_t i = 0; i < builderOutputs.get_size(); i++) {
+        if (!builderOutputs[i]->writer.mark(epoch) || !builderOutputs[i]->buffer.flush()) return false;
+    }
+    return true;
+}
+
+bool closeOutputs(Vector<BuilderOutput*>& builderOutputs) {
+    // Αποστολή των τελευταίων πλαισίων και κλείσιμο όλων των εξόδων προς τους builders
+    bool ok = true;
+    for (size_t i = 0; i < builderOutputs.get_size(); i++) {
+        if (!builderOutputs[i]->buffer.close()) ok = false;
+    }
+    return ok;
+}
+
+bool routeWord(const char* word, size_t length, const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs,
+               ProcessStats& stats) {
+    uint64_t hash = wordHash(word, length);
+    stats.words++;
+
+    // Έλεγχος αν η καθαρισμένη λέξη βρίσκεται στο σύνολο εξαιρέσεων
+    if (exclusionSet.containsHashed(word, length, hash)) {
+        stats.excluded++;
+        return true;
+    }
+
+    // Υπολογισμός του builder που θα λάβει τη λέξη
+    BuilderOutput& output = *builderOutputs[builderForHash(hash, static_cast<int>(builderOutputs.get_size()))];
+    if (output.combiner != nullptr) {
+        // Τοπική καταμέτρηση, με αποστολή μόνο όταν ο combiner ξεπεράσει το όριο μνήμης του
+        output.combiner->addHashed(word, length, hash, 1);
+        if (output.combiner->memoryUsage() > output.combinerLimit) return flushCombiner(output);
+        return true;
+    }
+
+    // Κωδικοποίηση της λέξης στο buffer του αντίστοιχου builder
+    output.records++;
+    return output.writer.word(word, length, hash, 1);
+}
+
+bool flushCombiner(BuilderOutput& output) {
+    WordMap& map = *output.combiner;
+    for (size_t i = 0; i < map.get_size(); i++) {
+        const WordMap::Entry& e = map.entry(i);
+        // Η τιμή κατακερματισμού είναι ήδη αποθηκευμένη στον combiner
+        if (!output.writer.word(map.word(e), e.length, e.hash, e.count)) return false;
+    }
+    output.records += static_cast<long long>(map.get_size());
+    map.reset();    // Χωρίς τη μνήμη της κορυφής, που θα ξεπερνούσε το όριο του combiner
+    return true;
+}
+
+void collectOutputStats(const Vector<BuilderOutput*>& builderOutputs, ProcessStats& stats) {
+    stats.sent.clear();
+    for (size_t j = 0; j < builderOutputs.get_size(); j++) {
+        const BuilderOutput& output = *builderOutputs[j];
+        stats.sent.push_back(output.records);
+        stats.writeCalls += static_cast<long long>(output.buffer.get_writeCalls());
+        stats.writeBlocked += output.buffer.get_blockedTime();
+    }
+}
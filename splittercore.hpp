@@ -0,0 +1,97 @@
+#ifndef SPLITTERCORE_HPP
+#define SPLITTERCORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "vector.hpp"
+#include "writebuffer.hpp"
+#include "wire.hpp"
+#include "wordmap.hpp"
+#include "exclusionset.hpp"
+#include "stats.hpp"
+
+class SpscRing;
+class ChunkQueue;
+
+// Η εργασία ενός splitter, κοινή για τη διεργασία ./splitter και για τα νήματα του laxen --threads.
+
+// Ρυθμίσεις ενός splitter
+struct SplitterOptions {
+    const char* inputFile;
+    long long startByte;        // Πρώτο byte του τμήματος
+    long long endByte;          // Ένα μετά το τελευταίο byte του τμήματος
+    const char* readerBackend;  // Backend ανάγνωσης εισόδου (mmap, pread, uring)
+    const char* tokenizerKernel;    // Πυρήνας κατηγοριοποίησης bytes (auto, scalar, sse2, avx2)
+    long long combineBytes;     // Όριο μνήμης του τοπικού combiner σε bytes (0 = χωρίς combiner)
+    ChunkQueue* chunks;         // Τμήματα από κοινό δρομέα αντί για το [startByte, endByte) (nullptr = σταθερό τμήμα)
+};
+
+// Νέο τμήμα της εισόδου από τη ρίζα προς έναν splitter μέσω του pipe ελέγχου (--follow).
+// Το μήνυμα είναι μικρότερο από PIPE_BUF και γράφεται ατομικά.
+struct RangeMessage {
+    long long startByte;
+    long long endByte;
+};
+
+// Έξοδος προς έναν builder: buffer πλαισίων και κωδικοποιητής εγγραφών του πρωτοκόλλου.
+// Με combiner οι λέξεις μετρώνται πρώτα τοπικά και στέλνονται ως ζεύγη (λέξη, count).
+struct BuilderOutput {
+    WriteBuffer buffer;
+    WireWriter writer;
+    WordMap* combiner;      // Τοπικά counts που δεν έχουν σταλεί ακόμα (nullptr χωρίς combiner)
+    size_t combinerLimit;   // Μνήμη του combiner πάνω από την οποία γίνεται αποστολή
+    long long records;      // Εγγραφές (λέξεις ή ζεύγη του combiner) που στάλθηκαν
+
+    BuilderOutput(int fd, size_t batchSize, unsigned flags) : buffer(fd, batchSize), writer(buffer, flags), combiner(nullptr), combinerLimit(0), records(0) {}
+    BuilderOutput(SpscRing* ring, size_t batchSize, unsigned flags) : buffer(ring, batchSize), writer(buffer, flags), combiner(nullptr), combinerLimit(0), records(0) {}
+    ~BuilderOutput() { delete combiner; }
+};
+
+// Επιλογή builder από την τιμή κατακερματισμού μιας λέξης. Χρησιμοποιούνται τα υψηλά bits,
+// ώστε τα χαμηλά bits (θέση στον WordMap του builder) να μένουν ομοιόμορφα κατανεμημένα.
+inline int builderForHash(uint64_t hash, int numOfBuilders) {
+    return static_cast<int>(((hash >> 32) * static_cast<uint64_t>(numOfBuilders)) >> 32);
+}
+
+// Ελέγχει μια καθαρισμένη λέξη στο σύνολο εξαιρέσεων και τη στέλνει στον builder που της αντιστοιχεί
+// (false σε σφάλμα εγγραφής). Η τιμή wordHash υπολογίζεται μία φορά και χρησιμοποιείται για τον
+// έλεγχο εξαίρεσης, την επιλογή builder, τον combiner και το πρωτόκολλο.
+bool routeWord(const char* word, size_t length, const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs,
+               ProcessStats& stats);
+
+// Παραλήπτης των λέξεων του Tokenizer
+struct WordRouter {
+    const ExclusionSet& exclusionSet;
+    Vector<BuilderOutput*>& builderOutputs;
+    ProcessStats& stats;
+
+    bool word(const char* word, size_t length) { return routeWord(word, length, exclusionSet, builderOutputs, stats); }
+};
+
+// Αποστολή όλων των counts του combiner στον builder και άδειασμα του combiner
+bool flushCombiner(BuilderOutput& output);
+
+// Διαβάζει το τμήμα της εισόδου (ή, με options.chunks, όσα τμήματα διεκδικήσει από την ουρά)
+// και στέλνει τις λέξεις του στις εξόδους (μία ανά builder).
+// Γράφει την κεφαλίδα κάθε ροής και στο τέλος, και σε σφάλμα, κλείνει όλες τις εξόδους,
+// ώστε οι builders να μην περιμένουν. Η αποδέσμευση των εξόδων γίνεται από τον καλούντα.
+// Τα bytes, οι γραμμές και οι λέξεις του τμήματος προστίθενται στο stats.
+bool runSplitter(const SplitterOptions& options, const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs,
+                 ProcessStats& stats);
+
+// Τα βήματα της runSplitter, για splitters που επεξεργάζονται διαδοχικά τμήματα (--follow):
+//   startSplitter: combiners και κεφαλίδα κάθε ροής
+//   splitRange:    το τμήμα [startByte, endByte) των options (ή τα τμήματα της ουράς), με αποστολή των
+//                  counts των combiners στο τέλος
+//   markEpoch:     σήμανση τέλους εποχής σε κάθε ροή και αποστολή των πλαισίων χωρίς αναμονή
+//   closeOutputs:  κλείσιμο όλων των εξόδων
+bool startSplitter(const SplitterOptions& options, Vector<BuilderOutput*>& builderOutputs);
+bool splitRange(const SplitterOptions& options, const ExclusionSet& exclusionSet, Vector<BuilderOutput*>& builderOutputs,
+                ProcessStats& stats);
+bool markEpoch(uint64_t epoch, Vector<BuilderOutput*>& builderOutputs);
+bool closeOutputs(Vector<BuilderOutput*>& builderOutputs);
+
+// Εγγραφές ανά builder, κλήσεις και χρόνος εγγραφής των εξόδων στο stats
+void collectOutputStats(const Vector<BuilderOutput*>& builderOutputs, ProcessStats& stats);
+
+#endif // SPLITTERCORE_HPP
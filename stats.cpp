@@ -0,0 +1,95 @@
+// stats.cpp
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+#include "stats.hpp"
+
+ProcessStats::ProcessStats()
+    : realTime(0), cpuTime(0), bytesRead(0), linesRead(0), chunks(0), readCalls(0), readBlocked(0), words(0), records(0),
+      excluded(0), tooShort(0), distinctWords(0), tableBytes(0), writeCalls(0), writeBlocked(0),
+      minorFaults(0), majorFaults(0), voluntarySwitches(0), involuntarySwitches(0), maxRssKb(0) {}
+
+void collectUsage(ProcessStats& stats, int who) {
+    struct rusage usage;
+    if (getrusage(who, &usage) == -1) return;
+    stats.minorFaults = usage.ru_minflt;
+    stats.majorFaults = usage.ru_majflt;
+    stats.voluntarySwitches = usage.ru_nvcsw;
+    stats.involuntarySwitches = usage.ru_nivcsw;
+    stats.maxRssKb = usage.ru_maxrss;
+}
+
+size_t formatDoneMessage(char* buffer, size_t size, const char* tag, int id, const ProcessStats& stats) {
+    int length = snprintf(buffer, size,
+                          "%s-%d-%f-%f bytes=%lld lines=%lld chunks=%lld reads=%lld rblock=%f words=%lld records=%lld excluded=%lld"
+                          " short=%lld distinct=%lld table=%lld writes=%lld wblock=%f minflt=%lld majflt=%lld"
+                          " nvcsw=%lld nivcsw=%lld maxrss=%lld",
+                          tag, id, stats.realTime, stats.cpuTime, stats.bytesRead, stats.linesRead, stats.chunks, stats.readCalls,
+                          stats.readBlocked, stats.words, stats.records, stats.excluded, stats.tooShort,
+                          stats.distinctWords, stats.tableBytes, stats.writeCalls, stats.writeBlocked,
+                          stats.minorFaults, stats.majorFaults, stats.voluntarySwitches, stats.involuntarySwitches,
+                          stats.maxRssKb);
+    if (length < 0 || static_cast<size_t>(length) >= size) return 0;
+
+    // Εγγραφές ανά builder, όσες χωρούν
+    size_t used = static_cast<size_t>(length);
+    for (size_t j = 0; j < stats.sent.get_size(); j++) {
+        char item[32];
+        int n = snprintf(item, sizeof(item), "%s%lld", j == 0 ? " sent=" : ",", stats.sent[j]);
+        if (used + static_cast<size_t>(n) >= size) break;
+        std::memcpy(buffer + used, item, static_cast<size_t>(n) + 1);
+        used += static_cast<size_t>(n);
+    }
+    return used;
+}
+
+bool parseDoneMessage(const char* message, const char* tag, int& id, ProcessStats& stats) {
+    size_t tagLength = std::strlen(tag);
+    if (std::strncmp(message, tag, tagLength) != 0) return false;
+    int consumed = 0;
+    if (sscanf(message + tagLength, "-%d-%lf-%lf%n", &id, &stats.realTime, &stats.cpuTime, &consumed) != 3) return false;
+
+    // Ζεύγη key=value χωρισμένα με κενά
+    const char* p = message + tagLength + consumed;
+    while (*p != '\0') {
+        while (*p == ' ') p++;
+        const char* equals = std::strchr(p, '=');
+        if (equals == NULL) break;
+        size_t keyLength = static_cast<size_t>(equals - p);
+        const char* value = equals + 1;
+        char* end;
+
+        if (keyLength == 4 && std::strncmp(p, "sent", 4) == 0) {
+            stats.sent.clear();
+            end = const_cast<char*>(value);
+            do {
+                stats.sent.push_back(std::strtoll(end + (*end == ',' ? 1 : 0), &end, 10));
+            } while (*end == ',');
+        } else {
+            struct Field { const char* key; long long* integer; double* real; };
+            const Field fields[] = {
+                { "bytes", &stats.bytesRead, NULL }, { "lines", &stats.linesRead, NULL },
+                { "chunks", &stats.chunks, NULL }, { "reads", &stats.readCalls, NULL },
+                { "rblock", NULL, &stats.readBlocked },
+                { "words", &stats.words, NULL }, { "records", &stats.records, NULL },
+                { "excluded", &stats.excluded, NULL }, { "short", &stats.tooShort, NULL },
+                { "distinct", &stats.distinctWords, NULL }, { "table", &stats.tableBytes, NULL },
+                { "writes", &stats.writeCalls, NULL }, { "wblock", NULL, &stats.writeBlocked },
+                { "minflt", &stats.minorFaults, NULL }, { "majflt", &stats.majorFaults, NULL },
+                { "nvcsw", &stats.voluntarySwitches, NULL }, { "nivcsw", &stats.involuntarySwitches, NULL },
+                { "maxrss", &stats.maxRssKb, NULL },
+            };
+            end = const_cast<char*>(value);
+            for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+                if (std::strlen(fields[f].key) != keyLength || std::strncmp(p, fields[f].key, keyLength) != 0) continue;
+                if (fields[f].integer != NULL) *fields[f].integer = std::strtoll(value, &end, 10);
+                else *fields[f].real = std::strtod(value, &end);
+                break;
+            }
+        }
+        p = end;
+        while (*p != '\0' && *p != ' ') p++;    // Παράκαμψη μη αναμενόμενων χαρακτήρων
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <cstddef>
+#include <ctime>
+#include "vector.hpp"
+
+// Μετρητές ενός splitter ή builder (διεργασίας ή νήματος), που στέλνονται στη ρίζα με το μήνυμα
+// ολοκλήρωσης και τυπώνονται από την printResults. Κάθε ρόλος συμπληρώνει όσους τον αφορούν.
+struct ProcessStats {
+    double realTime;            // Πραγματικός χρόνος (clock_gettime)
+    double cpuTime;             // CPU χρόνος της διεργασίας ή του νήματος (clock_gettime)
+
+    long long bytesRead;        // splitter: bytes του αρχείου, builder: bytes από τους splitters
+    long long linesRead;        // splitter: γραμμές του τμήματος
+    long long chunks;           // splitter: τμήματα που διεκδίκησε από την κοινή ουρά (--chunk)
+    long long readCalls;        // Κλήσεις ανάγνωσης (read/pread/io_uring ή αναγνώσεις από δακτύλιο)
+    double readBlocked;         // builder: χρόνος αναμονής για δεδομένα (epoll_wait ή κουδούνι)
+
+    long long words;            // splitter: καθαρισμένες λέξεις, builder: άθροισμα των counts που έλαβε
+    long long records;          // builder: εγγραφές του πρωτοκόλλου που έλαβε
+    long long excluded;         // splitter: λέξεις του συνόλου εξαιρέσεων
+    long long tooShort;         // splitter: λέξεις με ένα μόνο γράμμα
+    long long distinctWords;    // builder: διαφορετικές λέξεις στον πίνακα
+    long long tableBytes;       // builder: μνήμη του πίνακα
+
+    long long writeCalls;       // Κλήσεις write() (ή εγγραφές σε δακτύλιο)
+    double writeBlocked;        // splitter: χρόνος μέσα στις εγγραφές προς τους builders
+    Vector<long long> sent;     // splitter: εγγραφές που στάλθηκαν σε κάθε builder
+
+    long long minorFaults;      // getrusage
+    long long majorFaults;
+    long long voluntarySwitches;
+    long long involuntarySwitches;
+    long long maxRssKb;
+
+    ProcessStats();
+};
+
+// Χρόνος σε δευτερόλεπτα από ένα ρολόι του clock_gettime
+inline double clockSeconds(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+// Στοιχεία getrusage (RUSAGE_SELF ή RUSAGE_THREAD) στους μετρητές
+void collectUsage(ProcessStats& stats, int who);
+
+// Μήνυμα ολοκλήρωσης "<tag>-id-real-cpu key=value ...", μικρότερο από size bytes (μαζί με το '\0').
+// Αν δεν χωρούν όλα τα sent, η λίστα κόβεται. Επιστρέφει το μήκος του μηνύματος.
+size_t formatDoneMessage(char* buffer, size_t size, const char* tag, int id, const ProcessStats& stats);
+
+// Ανάλυση ενός μηνύματος της formatDoneMessage. Άγνωστα κλειδιά αγνοούνται.
+bool parseDoneMessage(const char* message, const char* tag, int& id, ProcessStats& stats);
+
+#endif // STATS_HPP
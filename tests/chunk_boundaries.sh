@@ -0,0 +1,38 @@
+#!/bin/bash
+# Έλεγχος των ορίων των τμημάτων της εισόδου: με κάθε --chunk (και --threads) τα counts πρέπει να είναι
+# ίδια με εκείνα της στατικής κατανομής και ίσα με τα αναμενόμενα. Η είσοδος έχει σε κάθε γραμμή ένα
+# μεγάλο κομμάτι χωρίς διαχωριστές και μετά πολλά κενά πριν από την αλλαγή γραμμής, ώστε τα όρια να
+# πέφτουν άλλοτε σε κενό και άλλοτε σε '\n' (τμήματα που επικαλύπτονταν μετρούσαν λέξεις δύο φορές).
+# Εκτελείται από τον κατάλογο του project με make check.
+
+lines=20
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"; rm -f fifo_*' EXIT
+
+awk -v lines=$lines 'BEGIN {
+    for (k = 0; k < 10000; k++) long = long "0"
+    for (i = 0; i < lines; i++) {
+        printf "%s", long
+        for (j = 0; j < 150; j++) printf " yy zz zz"
+        printf "\n"
+    }
+}' > "$dir/input.txt"
+printf 'the\n' > "$dir/exclusions.txt"
+
+failed=0
+for args in "--chunk 0" "--chunk 37" "--chunk 100" "--chunk 1000" "--chunk 4096" "--chunk 100 --threads" "--chunk 100 --transport shm"; do
+    if ! ./laxen -i "$dir/input.txt" -l 3 -m 2 -t 5 -e "$dir/exclusions.txt" -o "$dir/out" $args > /dev/null; then
+        echo "FAIL $args: laxen exited with an error"
+        failed=1
+        continue
+    fi
+    yy=$(awk '$2 == "yy" { print $3 }' "$dir/out")
+    zz=$(awk '$2 == "zz" { print $3 }' "$dir/out")
+    if [ "$yy" = $((lines * 150)) ] && [ "$zz" = $((lines * 300)) ]; then
+        echo "OK   $args"
+    else
+        echo "FAIL $args: yy=$yy zz=$zz (expected $((lines * 150)) and $((lines * 300)))"
+        failed=1
+    fi
+done
+exit $failed
@@ -0,0 +1,136 @@
+// tokenizer.cpp
+#include <cstring>
+#include "tokenizer.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TOKENIZER_X86 1
+#endif
+
+// Πίνακας κατηγοριών για τον scalar πυρήνα
+enum { CLASS_OTHER = 0, CLASS_SEPARATOR = 1, CLASS_LETTER = 2 };
+
+struct ClassTable {
+    unsigned char value[256];
+
+    ClassTable() {
+        memset(value, CLASS_OTHER, sizeof(value));
+        value[static_cast<unsigned char>(' ')] = CLASS_SEPARATOR;
+        value[static_cast<unsigned char>('\t')] = CLASS_SEPARATOR;
+        value[static_cast<unsigned char>('\n')] = CLASS_SEPARATOR;
+        for (int c = 'a'; c <= 'z'; c++) value[c] = CLASS_LETTER;
+        for (int c = 'A'; c <= 'Z'; c++) value[c] = CLASS_LETTER;
+    }
+};
+
+static const ClassTable classTable;
+
+static void classifyScalar(const char* in, size_t count, char* lower, ByteClasses* classes) {
+    for (size_t base = 0; base < count; base += 64) {
+        uint64_t separators = 0, letters = 0;
+        for (size_t i = 0; i < 64; i++) {
+            unsigned char c = static_cast<unsigned char>(in[base + i]);
+            unsigned char cls = classTable.value[c];
+            separators |= static_cast<uint64_t>(cls & CLASS_SEPARATOR) << i;
+            letters |= static_cast<uint64_t>(cls >> 1) << i;
+            // Για γράμματα το bit 0x20 δίνει το πεζό, τα υπόλοιπα bytes δεν χρησιμοποιούνται
+            lower[base + i] = static_cast<char>(c | 0x20);
+        }
+        classes[base / 64].separators = separators;
+        classes[base / 64].letters = letters;
+    }
+}
+
+#ifdef TOKENIZER_X86
+
+// 16 bytes με SSE2: επιστρέφει τις μάσκες των διαχωριστών και των γραμμάτων
+static inline void classify16(const char* in, char* lower, uint32_t& separators, uint32_t& letters) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+    __m128i sep = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                                            _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))),
+                               _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+    // Με το bit 0x20 τα κεφαλαία γίνονται πεζά. Τα bytes >= 0x80 είναι αρνητικά στη σύγκριση και απορρίπτονται.
+    __m128i low = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+    __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(low, _mm_set1_epi8('a' - 1)),
+                                   _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lower), low);
+    separators = static_cast<uint32_t>(_mm_movemask_epi8(sep));
+    letters = static_cast<uint32_t>(_mm_movemask_epi8(letter));
+}
+
+__attribute__((target("sse2")))
+static void classifySse2(const char* in, size_t count, char* lower, ByteClasses* classes) {
+    for (size_t base = 0; base < count; base += 64) {
+        uint64_t separators = 0, letters = 0;
+        for (size_t i = 0; i < 64; i += 16) {
+            uint32_t s, l;
+            classify16(in + base + i, lower + base + i, s, l);
+            separators |= static_cast<uint64_t>(s) << i;
+            letters |= static_cast<uint64_t>(l) << i;
+        }
+        classes[base / 64].separators = separators;
+        classes[base / 64].letters = letters;
+    }
+}
+
+// 32 bytes με AVX2
+__attribute__((target("avx2")))
+static inline void classify32(const char* in, char* lower, uint32_t& separators, uint32_t& letters) {
+    __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    __m256i sep = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                                                  _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+                                  _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+    __m256i low = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+    __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(low, _mm256_set1_epi8('a' - 1)),
+                                      _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), low));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lower), low);
+    separators = static_cast<uint32_t>(_mm256_movemask_epi8(sep));
+    letters = static_cast<uint32_t>(_mm256_movemask_epi8(letter));
+}
+
+__attribute__((target("avx2")))
+static void classifyAvx2(const char* in, size_t count, char* lower, ByteClasses* classes) {
+    for (size_t base = 0; base < count; base += 64) {
+        uint32_t s0, l0, s1, l1;
+        classify32(in + base, lower + base, s0, l0);
+        classify32(in + base + 32, lower + base + 32, s1, l1);
+        classes[base / 64].separators = s0 | static_cast<uint64_t>(s1) << 32;
+        classes[base / 64].letters = l0 | static_cast<uint64_t>(l1) << 32;
+    }
+}
+
+#endif // TOKENIZER_X86
+
+bool isTokenizerKernel(const char* name) {
+    return strcmp(name, "auto") == 0 || strcmp(name, "scalar") == 0 || strcmp(name, "sse2") == 0 || strcmp(name, "avx2") == 0;
+}
+
+ClassifyKernel selectTokenizerKernel(const char* name) {
+#ifdef TOKENIZER_X86
+    __builtin_cpu_init();
+    bool hasAvx2 = __builtin_cpu_supports("avx2");
+    bool hasSse2 = __builtin_cpu_supports("sse2");
+    bool automatic = strcmp(name, "auto") == 0;
+    if ((automatic || strcmp(name, "avx2") == 0) && hasAvx2) return classifyAvx2;
+    if ((automatic || strcmp(name, "sse2") == 0) && hasSse2) return classifySse2;
+#else
+    (void)name;
+#endif
+    return classifyScalar;
+}
+
+Tokenizer::Tokenizer(ClassifyKernel kernel) : kernel(kernel), word(new char[256]), length(0), capacity(256), shortWords(0) {}
+
+Tokenizer::~Tokenizer() {
+    delete[] word;
+}
+
+void Tokenizer::grow() {
+    size_t newCapacity = capacity * 2;
+    while (length + 64 > newCapacity) newCapacity *= 2;
+    char* newWord = new char[newCapacity];
+    memcpy(newWord, word, length);
+    delete[] word;
+    word = newWord;
+    capacity = newCapacity;
+}
@@ -0,0 +1,159 @@
+#ifndef TOKENIZER_HPP
+#define TOKENIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Τμηματοποίηση του κειμένου σε λέξεις και καθαρισμός τους.
+//
+// Κανόνες (ίδιοι με τον αρχικό cleanWord):
+//   - διαχωριστές είναι μόνο τα ' ', '\t' και '\n'
+//   - από κάθε λέξη κρατιούνται μόνο τα γράμματα A-Z, a-z, σε πεζά
+//   - λέξεις με λιγότερα από 2 γράμματα αγνοούνται
+//
+// Η κατηγοριοποίηση των bytes γίνεται από έναν πυρήνα (scalar, SSE2 ή AVX2) που
+// επιλέγεται κατά την εκτέλεση και παράγει για κάθε 64 bytes δύο μάσκες bits
+// (διαχωριστές και γράμματα) και ένα αντίγραφο των bytes σε πεζά.
+
+// Μάσκες για 64 συνεχόμενα bytes: bit i = byte i
+struct ByteClasses {
+    uint64_t separators;
+    uint64_t letters;
+};
+
+// Πυρήνας κατηγοριοποίησης: count bytes από το in (πολλαπλάσιο του 64),
+// με γραφή των πεζών στο lower και μιας ByteClasses ανά 64 bytes στο classes
+typedef void (*ClassifyKernel)(const char* in, size_t count, char* lower, ByteClasses* classes);
+
+// Έλεγχος αν το όνομα αντιστοιχεί σε πυρήνα ("auto", "scalar", "sse2", "avx2")
+bool isTokenizerKernel(const char* name);
+
+// Επιλογή πυρήνα με βάση το όνομα. Με "auto" επιλέγεται ο ταχύτερος που υποστηρίζει η CPU.
+// Αν ο ζητούμενος πυρήνας δεν υποστηρίζεται, χρησιμοποιείται ο scalar.
+ClassifyKernel selectTokenizerKernel(const char* name);
+
+// Τμηματοποιεί διαδοχικά blocks κειμένου. Μια λέξη μπορεί να διασχίζει το όριο δύο blocks.
+// Κάθε καθαρισμένη λέξη παραδίδεται στο sink.word(word, length), που επιστρέφει false για διακοπή.
+// Η λέξη δείχνει σε εσωτερικό buffer και ισχύει μόνο μέσα στην κλήση. Δεν γίνεται καμία
+// δέσμευση μνήμης ανά λέξη: οι περισσότερες λέξεις παραδίδονται κατευθείαν από το αντίγραφο
+// σε πεζά, και μόνο όσες περιέχουν άλλα σύμβολα ή διασχίζουν όριο 64 bytes συναρμολογούνται
+// σε έναν buffer που επαναχρησιμοποιείται.
+class Tokenizer {
+private:
+    static const size_t CHUNK = 4096;   // Bytes που κατηγοριοποιούνται με μία κλήση του πυρήνα
+
+    ClassifyKernel kernel;
+    char lower[CHUNK + 64];             // Τα bytes του τρέχοντος κομματιού σε πεζά (+64 για αντιγραφές σταθερού μεγέθους)
+    ByteClasses classes[CHUNK / 64];
+    char* word;                         // Τα γράμματα της λέξης που συναρμολογείται
+    size_t length;
+    size_t capacity;
+    size_t shortWords;                  // Λέξεις με ένα μόνο γράμμα που αγνοήθηκαν
+
+    Tokenizer(const Tokenizer&);              // Δεν επιτρέπεται αντιγραφή
+    Tokenizer& operator=(const Tokenizer&);
+
+    // Μεγαλώνει τον buffer της λέξης ώστε να χωρούν άλλα 64 bytes
+    void grow();
+
+    // Προσθήκη των γραμμάτων του src[0, count) που σημειώνει το letters (bit 0 = src[0])
+    void appendLetters(const char* src, size_t count, uint64_t letters) {
+        // Χώρος για αντιγραφή 64 bytes πάντα, ώστε το memcpy να έχει σταθερό μέγεθος
+        if (length + 64 > capacity) grow();
+
+        uint64_t all = count == 64 ? ~0ULL : (1ULL << count) - 1;
+        letters &= all;
+        if (letters == all) {
+            // Μόνο γράμματα: αντιγραφή ολόκληρου του τμήματος (τα bytes μετά το count αγνοούνται)
+            std::memcpy(word + length, src, 64);
+            length += count;
+            return;
+        }
+        // Συλλογή μόνο των γραμμάτων, παραλείποντας στίξη, ψηφία κ.λπ.
+        while (letters != 0) {
+            word[length++] = src[__builtin_ctzll(letters)];
+            letters &= letters - 1;
+        }
+    }
+
+    // Ολοκλήρωση της τρέχουσας λέξης και παράδοσή της στο sink αν έχει τουλάχιστον 2 γράμματα
+    template <typename Sink>
+    bool endWord(Sink& sink) {
+        size_t n = length;
+        length = 0;
+        if (n < 2) {
+            if (n == 1) shortWords++;
+            return true;
+        }
+        return sink.word(word, n);
+    }
+
+public:
+    explicit Tokenizer(ClassifyKernel kernel);
+    ~Tokenizer();
+
+    // Επεξεργασία ενός block (false αν το sink διέκοψε)
+    template <typename Sink>
+    bool feed(const char* data, size_t count, Sink& sink);
+
+    // Ολοκλήρωση της τελευταίας λέξης στο τέλος της εισόδου
+    template <typename Sink>
+    bool finish(Sink& sink) { return endWord(sink); }
+
+    size_t get_shortWords() const { return shortWords; }
+};
+
+template <typename Sink>
+bool Tokenizer::feed(const char* data, size_t count, Sink& sink) {
+    while (count > 0) {
+        size_t n = count < CHUNK ? count : CHUNK;
+        size_t padded = (n + 63) & ~static_cast<size_t>(63);
+        if (padded == n) {
+            kernel(data, n, lower, classes);
+        } else {
+            // Το τελευταίο κομμάτι συμπληρώνεται ώστε ο πυρήνας να δουλεύει πάντα σε 64 bytes.
+            // Τα bytes συμπλήρωσης δεν εξετάζονται.
+            char tail[CHUNK];
+            std::memcpy(tail, data, n);
+            std::memset(tail + n, ' ', padded - n);
+            kernel(tail, padded, lower, classes);
+        }
+
+        for (size_t base = 0; base < n; base += 64) {
+            size_t limit = n - base < 64 ? n - base : 64;
+            uint64_t valid = limit == 64 ? ~0ULL : (1ULL << limit) - 1;
+            uint64_t separators = classes[base / 64].separators & valid;
+            uint64_t letters = classes[base / 64].letters & valid;
+            const char* src = lower + base;
+
+            size_t pos = 0;
+            while (pos < limit) {
+                // Το επόμενο τμήμα χωρίς διαχωριστές ανήκει στην τρέχουσα λέξη
+                uint64_t rest = separators >> pos;
+                size_t next = rest != 0 ? pos + __builtin_ctzll(rest) : limit;
+                size_t span = next - pos;
+                uint64_t spanMask = span < 64 ? (1ULL << span) - 1 : ~0ULL;
+
+                if (length == 0 && next < limit && span >= 2 && ((letters >> pos) & spanMask) == spanMask) {
+                    // Ολόκληρη η λέξη, μόνο με γράμματα, μέσα στα ίδια 64 bytes:
+                    // παράδοση απευθείας από το lower χωρίς αντιγραφή
+                    if (!sink.word(src + pos, span)) return false;
+                } else {
+                    if (span > 0) appendLetters(src + pos, span, letters >> pos);
+                    if (next == limit) break;
+                    if (!endWord(sink)) return false;
+                }
+                // Παράκαμψη συνεχόμενων διαχωριστών
+                uint64_t words = ~separators >> next;
+                pos = words != 0 ? next + __builtin_ctzll(words) : limit;
+            }
+        }
+
+        data += n;
+        count -= n;
+    }
+    return true;
+}
+
+#endif // TOKENIZER_HPP
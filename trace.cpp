@@ -0,0 +1,88 @@
+// trace.cpp
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "trace.hpp"
+
+thread_local TraceBuffer* currentTrace = nullptr;
+
+TraceBuffer::TraceBuffer(const char* label, bool ownProcess) : ownProcess(ownProcess), pid(getpid()), tid(pid) {
+    snprintf(this->label, sizeof(this->label), "%s", label);
+}
+
+void TraceBuffer::activate() {
+    tid = static_cast<int>(syscall(SYS_gettid));
+    currentTrace = this;
+}
+
+// Προσθήκη μορφοποιημένου κειμένου στο τέλος του buffer
+static void appendText(Vector<char>& out, const char* text, int length) {
+    for (int i = 0; i < length; i++) out.push_back(text[i]);
+}
+
+bool TraceBuffer::writeTo(int fd, bool last) const {
+    Vector<char> out;
+    out.reserve(spans.get_size() * 96 + 256);
+    char line[256];
+    int length;
+
+    // Ονόματα διεργασίας και νήματος (metadata events)
+    if (ownProcess) {
+        length = snprintf(line, sizeof(line), "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"name\": \"%s\"}},\n",
+                          pid, label);
+        appendText(out, line, length);
+    }
+    length = snprintf(line, sizeof(line), "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                      pid, tid, label);
+    appendText(out, line, length);
+
+    // Ένα complete event ανά διάστημα, με χρόνους σε μικροδευτερόλεπτα
+    for (size_t i = 0; i < spans.get_size(); i++) {
+        length = snprintf(line, sizeof(line), ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": %d, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                          spans[i].name, pid, tid, spans[i].begin * 1e6, (spans[i].end - spans[i].begin) * 1e6);
+        appendText(out, line, length);
+    }
+    appendText(out, last ? "\n]\n" : ",\n", last ? 3 : 2);
+
+    const char* bytes = out.data();
+    size_t count = out.get_size();
+    while (count > 0) {
+        ssize_t bytes_written = write(fd, bytes, count);
+        if (bytes_written == -1) {
+            if (errno == EINTR) continue;
+            std::perror("write trace");
+            return false;
+        }
+        bytes += bytes_written;
+        count -= static_cast<size_t>(bytes_written);
+    }
+    return true;
+}
+
+int createTraceFile(const char* path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        std::perror("open trace file");
+        return -1;
+    }
+    if (write(fd, "[\n", 2) != 2) {
+        std::perror("write trace");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool appendTraceFile(const char* path, const TraceBuffer& trace) {
+    int fd = open(path, O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd == -1) {
+        std::perror("open trace file");
+        return false;
+    }
+    bool ok = trace.writeTo(fd, false);
+    close(fd);
+    return ok;
+}
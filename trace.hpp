@@ -0,0 +1,75 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstddef>
+#include "vector.hpp"
+#include "stats.hpp"
+
+// Καταγραφή των φάσεων (άνοιγμα FIFOs, ανάγνωση, τμηματοποίηση, εγγραφή, καταμέτρηση, επιλογή topK,
+// αποστολή αποτελεσμάτων) ως διαστήματα με αρχή και τέλος (--trace). Κάθε διεργασία ή νήμα γεμίζει
+// το δικό του TraceBuffer και στο τέλος το προσθέτει στο κοινό αρχείο, σε μορφή Chrome trace-event
+// (πίνακας JSON με events "ph": "X"), που ανοίγει στο chrome://tracing και στο ui.perfetto.dev.
+// Οι χρόνοι είναι από το CLOCK_MONOTONIC, κοινό για όλες τις διεργασίες του μηχανήματος.
+class TraceBuffer {
+private:
+    struct Span {
+        const char* name;   // Όνομα της φάσης (σταθερή συμβολοσειρά)
+        double begin;
+        double end;
+    };
+
+    Vector<Span> spans;
+    char label[32];         // Όνομα της διεργασίας ή του νήματος στο trace (π.χ. "splitter 2")
+    bool ownProcess;        // Η ετικέτα ονομάζει και τη διεργασία (όχι μόνο το νήμα)
+    int pid;
+    int tid;
+
+public:
+    TraceBuffer(const char* label, bool ownProcess);
+
+    // Το buffer γίνεται το trace του τρέχοντος νήματος
+    void activate();
+
+    void record(const char* name, double begin, double end) {
+        Span span = { name, begin, end };
+        spans.push_back(span);
+    }
+
+    // Προσθήκη των events στο αρχείο με μία write (το fd είναι ανοιχτό με O_APPEND, ώστε οι
+    // εγγραφές των διεργασιών να μην αναμειγνύονται). Κάθε event ακολουθείται από κόμμα, εκτός
+    // αν last, οπότε ο πίνακας JSON κλείνει.
+    bool writeTo(int fd, bool last) const;
+};
+
+// Το trace του τρέχοντος νήματος (nullptr χωρίς --trace)
+extern thread_local TraceBuffer* currentTrace;
+
+// Διάστημα μιας φάσης, από τη δημιουργία μέχρι την καταστροφή του αντικειμένου.
+// Χωρίς trace κοστίζει έναν έλεγχο δείκτη, οπότε μπαίνει μόνο γύρω από blocks, όχι ανά λέξη.
+class TraceSpan {
+private:
+    const char* name;
+    double begin;
+
+    TraceSpan(const TraceSpan&);                // Δεν επιτρέπεται αντιγραφή
+    TraceSpan& operator=(const TraceSpan&);
+
+public:
+    explicit TraceSpan(const char* name) : name(name), begin(currentTrace != nullptr ? clockSeconds(CLOCK_MONOTONIC) : 0) {}
+    ~TraceSpan() { end(); }
+
+    // Τέλος του διαστήματος πριν από το τέλος της εμβέλειας του αντικειμένου
+    void end() {
+        if (currentTrace != nullptr && name != nullptr) currentTrace->record(name, begin, clockSeconds(CLOCK_MONOTONIC));
+        name = nullptr;
+    }
+};
+
+// Δημιουργία (ή άδειασμα) του αρχείου trace από τη ρίζα και εγγραφή της αρχής του πίνακα JSON.
+// Επιστρέφει fd για προσθήκη events ή -1 σε αποτυχία.
+int createTraceFile(const char* path);
+
+// Προσθήκη των events μιας διεργασίας-παιδιού στο αρχείο trace που έχει δημιουργήσει η ρίζα
+bool appendTraceFile(const char* path, const TraceBuffer& trace);
+
+#endif // TRACE_HPP
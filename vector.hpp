@@ -2,112 +2,248 @@
 #define VECTOR_HPP
 
 #include <stdexcept> // Για διαχείριση εξαιρέσεων
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <type_traits>
 
+// Δυναμικός πίνακας. Η μνήμη δεσμεύεται χωρίς κατασκευή στοιχείων: κάθε στοιχείο κατασκευάζεται
+// μόνο όταν προστεθεί. Για τύπους που αντιγράφονται με memcpy (trivially copyable) η αύξηση
+// της χωρητικότητας γίνεται με realloc, αλλιώς τα στοιχεία μετακινούνται (move) στη νέα μνήμη.
+//
+// Ο operator[] δεν ελέγχει τα όρια, ώστε να μην επιβαρύνει τους βρόχους. Για πρόσβαση με
+// έλεγχο ορίων υπάρχει η at().
 template <typename T>
 class Vector {
 private:
-    T* data;         // Δείκτης στον δυναμικό πίνακα
+    T* items;        // Δείκτης στον δυναμικό πίνακα
     size_t capacity; // Τρέχουσα χωρητικότητα του vector
     size_t size;     // Πλήθος των στοιχείων στο vector
 
-    // Συνάρτηση για να αλλάζει το μέγεθος του πίνακα όταν γεμίσει
+    // Αλλαγή της χωρητικότητας (new_capacity >= size)
     void resize(size_t new_capacity);
 
+    // Χωρητικότητα για τουλάχιστον ένα ακόμα στοιχείο
+    void grow() { resize(capacity == 0 ? 1 : 2 * capacity); }
+
+    // Καταστροφή των στοιχείων [from, size)
+    void destroyFrom(size_t from);
+
 public:
     Vector();
     Vector(const Vector<T>& other);     // Copy constructor
+    Vector(Vector<T>&& other) noexcept; // Move constructor
     ~Vector();
 
     void push_back(const T& value);
+    void push_back(T&& value);
+
+    // Κατασκευή του νέου στοιχείου απευθείας στη θέση του
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
     void pop_back();
+    void clear();       // Αφαίρεση όλων των στοιχείων χωρίς αποδέσμευση της μνήμης
+
+    void reserve(size_t new_capacity);  // Χωρητικότητα τουλάχιστον new_capacity στοιχείων
+    void shrink_to_fit();               // Αποδέσμευση της μνήμης που δεν χρησιμοποιείται
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    T& at(size_t index);
+    const T& at(size_t index) const;
 
-    T& operator[](size_t index);
-    const T& operator[](size_t index) const;
     Vector<T>& operator=(const Vector<T>& other);
+    Vector<T>& operator=(Vector<T>&& other) noexcept;
     size_t get_size() const;
     size_t get_capacity() const;
 
-    bool find(const T& value) const; 
+    // Πρόσβαση στον πίνακα των στοιχείων
+    T* data() { return items; }
+    const T* data() const { return items; }
+    T* begin() { return items; }
+    T* end() { return items + size; }
+    const T* begin() const { return items; }
+    const T* end() const { return items + size; }
+
+    bool find(const T& value) const;
 };
 
 // Υλοποιήσεις συναρτήσεων template
 
 template <typename T>
-Vector<T>::Vector() : data(nullptr), capacity(0), size(0) {}
+Vector<T>::Vector() : items(nullptr), capacity(0), size(0) {}
 
 template <typename T>
-Vector<T>::Vector(const Vector<T>& other) : data(nullptr), capacity(other.capacity), size(other.size) {
+Vector<T>::Vector(const Vector<T>& other) : items(nullptr), capacity(0), size(0) {
     // Αντιγραφή του πίνακα δεδομένων
-    if (capacity > 0) {
-        data = new T[capacity];
-        for (size_t i = 0; i < size; ++i) {
-            data[i] = other.data[i];
-        }
+    reserve(other.size);
+    for (size_t i = 0; i < other.size; ++i) {
+        new (items + i) T(other.items[i]);
     }
+    size = other.size;
+}
+
+template <typename T>
+Vector<T>::Vector(Vector<T>&& other) noexcept : items(other.items), capacity(other.capacity), size(other.size) {
+    // Ανάληψη της μνήμης του other χωρίς αντιγραφή
+    other.items = nullptr;
+    other.capacity = 0;
+    other.size = 0;
 }
 
 template <typename T>
 Vector<T>::~Vector() {
-    delete[] data;
+    destroyFrom(0);
+    std::free(items);
+}
+
+template <typename T>
+void Vector<T>::destroyFrom(size_t from) {
+    if (!std::is_trivially_destructible<T>::value) {
+        for (size_t i = from; i < size; i++) items[i].~T();
+    }
+    size = from;
 }
 
 template <typename T>
 void Vector<T>::resize(size_t new_capacity) {
-    T* new_data = new T[new_capacity]; // Δέσμευση νέας μνήμης
-    for (size_t i = 0; i < size; i++) {
-        new_data[i] = data[i]; // Αντιγραφή των παλιών στοιχείων στον νέο πίνακα
+    if (new_capacity == 0) {
+        std::free(items);
+        items = nullptr;
+        capacity = 0;
+        return;
     }
-    delete[] data;  // Διαγραφή του παλιού πίνακα
-    data = new_data; // Δείκτης στον νέο πίνακα
+
+    T* new_items;
+    if (std::is_trivially_copyable<T>::value) {
+        // Τα bytes μεταφέρονται από τη realloc, συχνά χωρίς καν αντιγραφή
+        new_items = static_cast<T*>(std::realloc(static_cast<void*>(items), new_capacity * sizeof(T)));
+        if (new_items == nullptr) throw std::bad_alloc();
+    } else {
+        new_items = static_cast<T*>(std::malloc(new_capacity * sizeof(T))); // Δέσμευση νέας μνήμης
+        if (new_items == nullptr) throw std::bad_alloc();
+        for (size_t i = 0; i < size; i++) {
+            new (new_items + i) T(std::move(items[i])); // Μετακίνηση των παλιών στοιχείων στον νέο πίνακα
+            items[i].~T();
+        }
+        std::free(items);   // Αποδέσμευση του παλιού πίνακα
+    }
+    items = new_items; // Δείκτης στον νέο πίνακα
     capacity = new_capacity;
 }
 
 template <typename T>
 void Vector<T>::push_back(const T& value) {
     if (size == capacity) {
-        resize(capacity == 0 ? 1 : 2 * capacity); // Διπλασιασμός της χωρητικότητας
+        // Το value μπορεί να είναι στοιχείο του ίδιου του vector: αντίγραφο πριν τη μετακίνηση της μνήμης
+        T copy(value);
+        grow(); // Διπλασιασμός της χωρητικότητας
+        new (items + size) T(std::move(copy));
+    } else {
+        new (items + size) T(value);
+    }
+    size++; // Αύξηση του μεγέθους
+}
+
+template <typename T>
+void Vector<T>::push_back(T&& value) {
+    if (size == capacity) {
+        T moved(std::move(value));
+        grow();
+        new (items + size) T(std::move(moved));
+    } else {
+        new (items + size) T(std::move(value));
+    }
+    size++;
+}
+
+template <typename T>
+template <typename... Args>
+T& Vector<T>::emplace_back(Args&&... args) {
+    if (size == capacity) {
+        // Τα ορίσματα μπορεί να αναφέρονται σε στοιχεία του vector: κατασκευή πριν τη μετακίνηση της μνήμης
+        T value(std::forward<Args>(args)...);
+        grow();
+        new (items + size) T(std::move(value));
+    } else {
+        new (items + size) T(std::forward<Args>(args)...);
     }
-    data[size++] = value; // Προσθήκη στοιχείου και αύξηση του μεγέθους
+    return items[size++];
 }
 
 template <typename T>
 void Vector<T>::pop_back() {
     if (size > 0) {
-        size--; // Μείωση του μεγέθους (δεν χρειάζεται αποδέσμευση μνήμης)
+        destroyFrom(size - 1); // Καταστροφή του τελευταίου στοιχείου (η μνήμη παραμένει δεσμευμένη)
     } else {
         throw std::out_of_range("Το vector είναι άδειο");
     }
 }
 
 template <typename T>
-T& Vector<T>::operator[](size_t index) {
+void Vector<T>::clear() {
+    destroyFrom(0);
+}
+
+template <typename T>
+void Vector<T>::reserve(size_t new_capacity) {
+    if (new_capacity > capacity) resize(new_capacity);
+}
+
+template <typename T>
+void Vector<T>::shrink_to_fit() {
+    if (size < capacity) resize(size);
+}
+
+template <typename T>
+T& Vector<T>::at(size_t index) {
     if (index >= size) {
         throw std::out_of_range("Ο δείκτης είναι εκτός ορίων");
     }
-    return data[index];
+    return items[index];
 }
 
 template <typename T>
-const T& Vector<T>::operator[](size_t index) const {
-    return data[index];
+const T& Vector<T>::at(size_t index) const {
+    if (index >= size) {
+        throw std::out_of_range("Ο δείκτης είναι εκτός ορίων");
+    }
+    return items[index];
 }
 
 template <typename T>
 Vector<T>& Vector<T>::operator=(const Vector<T>& other) {
     if (this != &other) { // Έλεγχος για αυτοαντιστοίχιση (self-assignment)
-        delete[] data; // Αποδέσμευση τρέχοντος πίνακα
+        clear(); // Καταστροφή των τρεχόντων στοιχείων, η μνήμη επαναχρησιμοποιείται
 
         // Αντιγραφή των δεδομένων
-        capacity = other.capacity;
-        size = other.size;
-        data = new T[capacity];
-        for (size_t i = 0; i < size; ++i) {
-            data[i] = other.data[i];
+        reserve(other.size);
+        for (size_t i = 0; i < other.size; ++i) {
+            new (items + i) T(other.items[i]);
         }
+        size = other.size;
     }
     return *this; // Επιστροφή της τρέχουσας κλάσης
 }
 
+template <typename T>
+Vector<T>& Vector<T>::operator=(Vector<T>&& other) noexcept {
+    if (this != &other) {
+        destroyFrom(0);
+        std::free(items);
+
+        // Ανάληψη της μνήμης του other
+        items = other.items;
+        capacity = other.capacity;
+        size = other.size;
+        other.items = nullptr;
+        other.capacity = 0;
+        other.size = 0;
+    }
+    return *this;
+}
+
 template <typename T>
 size_t Vector<T>::get_size() const {
     return size;
@@ -121,11 +257,11 @@ size_t Vector<T>::get_capacity() const {
 template <typename T>
 bool Vector<T>::find(const T& value) const {
     for (size_t i = 0; i < size; ++i) {
-        if (data[i] == value) {
-            return true; 
+        if (items[i] == value) {
+            return true;
         }
     }
-    return false; 
+    return false;
 }
 
 #endif // VECTOR_HPP
@@ -0,0 +1,156 @@
+// wire.cpp
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include "wire.hpp"
+
+// Μέγιστο αποδεκτό μήκος λέξης (προστασία από κατεστραμμένα δεδομένα)
+static const uint64_t WIRE_MAX_WORD = 1 << 30;
+
+// Κωδικοποίηση varint στο out, επιστρέφει το πλήθος των bytes
+static size_t encodeVarint(uint64_t value, unsigned char* out) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<unsigned char>(value);
+    return n;
+}
+
+// Αποκωδικοποίηση varint από [p, limit). Επιστρέφει τα bytes που καταναλώθηκαν,
+// 0 αν το varint δεν έχει φτάσει ολόκληρο και -1 αν είναι μη έγκυρο.
+static int decodeVarint(const unsigned char* p, const unsigned char* limit, uint64_t& value) {
+    value = 0;
+    for (int i = 0; i < 10; i++) {
+        if (p + i >= limit) return 0;
+        value |= static_cast<uint64_t>(p[i] & 0x7f) << (7 * i);
+        if ((p[i] & 0x80) == 0) return i + 1;
+    }
+    return -1;
+}
+
+bool WireWriter::begin() {
+    char header[4] = { 'L', 'X', static_cast<char>(WIRE_VERSION), static_cast<char>(flags) };
+    return out.append(header, sizeof(header));
+}
+
+bool WireWriter::word(const char* word, size_t length, uint64_t hash, uint64_t count, uint64_t error) {
+    unsigned char prefix[10];
+    size_t n = encodeVarint(length, prefix);
+    if (!out.append(reinterpret_cast<char*>(prefix), n)) return false;
+    if (!out.append(word, length)) return false;
+
+    unsigned char suffix[28];
+    n = 0;
+    if (flags & WIRE_HASHES) {
+        for (int i = 0; i < 8; i++) suffix[n++] = static_cast<unsigned char>(hash >> (8 * i));
+    }
+    n += encodeVarint(count, suffix + n);
+    if (flags & WIRE_ERRORS) n += encodeVarint(error, suffix + n);
+    return out.append(reinterpret_cast<char*>(suffix), n);
+}
+
+bool WireWriter::mark(uint64_t epoch) {
+    unsigned char frame[11];
+    frame[0] = 0;   // Μήκος 0: πλαίσιο ελέγχου
+    size_t n = 1 + encodeVarint(epoch, frame + 1);
+    return out.append(reinterpret_cast<char*>(frame), n);
+}
+
+WireReader::WireReader() : buffer(new char[64 * 1024]), start(0), end(0), capacity(64 * 1024), headerSeen(false), flags(0) {}
+
+WireReader::~WireReader() {
+    delete[] buffer;
+}
+
+char* WireReader::prepare(size_t minSpace, size_t& available) {
+    // Μετακίνηση της μισής εγγραφής στην αρχή του buffer
+    if (start > 0) {
+        memmove(buffer, buffer + start, end - start);
+        end -= start;
+        start = 0;
+    }
+    if (capacity - end < minSpace) {
+        size_t newCapacity = capacity * 2;
+        while (newCapacity - end < minSpace) newCapacity *= 2;
+        char* newBuffer = new char[newCapacity];
+        memcpy(newBuffer, buffer, end);
+        delete[] buffer;
+        buffer = newBuffer;
+        capacity = newCapacity;
+    }
+    available = capacity - end;
+    return buffer + end;
+}
+
+ssize_t WireReader::readFrom(int fd) {
+    size_t available;
+    char* space = prepare(4096, available);
+    ssize_t bytes_read = read(fd, space, available);
+    while (bytes_read == -1 && errno == EINTR) bytes_read = read(fd, space, available);
+    if (bytes_read > 0) commit(bytes_read);
+    return bytes_read;
+}
+
+WireStatus WireReader::next(WireRecord& record) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer + start);
+    const unsigned char* limit = reinterpret_cast<const unsigned char*>(buffer + end);
+
+    if (!headerSeen) {
+        if (limit - p < 4) return WIRE_NEED_MORE;
+        if (p[0] != 'L' || p[1] != 'X' || p[2] != WIRE_VERSION) return WIRE_ERROR;
+        flags = p[3];
+        headerSeen = true;
+        p += 4;
+        start += 4;
+    }
+
+    uint64_t length;
+    int n = decodeVarint(p, limit, length);
+    if (n == 0) return WIRE_NEED_MORE;
+    if (n < 0 || length > WIRE_MAX_WORD) return WIRE_ERROR;
+    p += n;
+
+    if (length == 0) {
+        // Σήμανση εποχής: μόνο ο αριθμός της
+        record.word = nullptr;
+        record.length = 0;
+        record.hash = 0;
+        record.error = 0;
+        n = decodeVarint(p, limit, record.count);
+        if (n == 0) return WIRE_NEED_MORE;
+        if (n < 0) return WIRE_ERROR;
+        start = reinterpret_cast<const char*>(p + n) - buffer;
+        return WIRE_MARK;
+    }
+
+    if (static_cast<uint64_t>(limit - p) < length) return WIRE_NEED_MORE;
+    record.word = reinterpret_cast<const char*>(p);
+    record.length = static_cast<size_t>(length);
+    p += length;
+
+    record.hash = 0;
+    if (flags & WIRE_HASHES) {
+        if (limit - p < 8) return WIRE_NEED_MORE;
+        for (int i = 0; i < 8; i++) record.hash |= static_cast<uint64_t>(p[i]) << (8 * i);
+        p += 8;
+    }
+
+    n = decodeVarint(p, limit, record.count);
+    if (n == 0) return WIRE_NEED_MORE;
+    if (n < 0) return WIRE_ERROR;
+    p += n;
+
+    record.error = 0;
+    if (flags & WIRE_ERRORS) {
+        n = decodeVarint(p, limit, record.error);
+        if (n == 0) return WIRE_NEED_MORE;
+        if (n < 0) return WIRE_ERROR;
+        p += n;
+    }
+
+    // Η εγγραφή είναι ολόκληρη: κατανάλωση των bytes της
+    start = reinterpret_cast<const char*>(p) - buffer;
+    return WIRE_RECORD;
+}
@@ -0,0 +1,102 @@
+#ifndef WIRE_HPP
+#define WIRE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "writebuffer.hpp"
+
+// Δυαδικό πρωτόκολλο επικοινωνίας splitter -> builder -> laxen.
+//
+// Κάθε ροή ξεκινά με κεφαλίδα 4 bytes: 'L' 'X' έκδοση flags.
+// Ακολουθούν εγγραφές της μορφής:
+//     varint μήκος λέξης (> 0)
+//     bytes της λέξης
+//     8 bytes hash (little endian), μόνο αν flags & WIRE_HASHES
+//     varint count
+//     varint σφάλμα του count, μόνο αν flags & WIRE_ERRORS
+// Μήκος 0 δηλώνει πλαίσιο ελέγχου: σήμανση τέλους εποχής (--follow), που ακολουθείται από
+//     varint αριθμός εποχής
+// Τα varint είναι unsigned LEB128 (7 bits ανά byte, το υψηλό bit δηλώνει συνέχεια).
+
+const unsigned char WIRE_VERSION = 1;
+
+// Flags της κεφαλίδας
+const unsigned WIRE_HASHES = 0x01;     // Κάθε εγγραφή περιέχει την τιμή wordHash της λέξης
+const unsigned WIRE_ERRORS = 0x02;     // Κάθε εγγραφή περιέχει το μέγιστο σφάλμα του count (--approx)
+
+// Αποτελέσματα της WireReader::next()
+enum WireStatus {
+    WIRE_RECORD,        // Διαβάστηκε μια ολοκληρωμένη εγγραφή
+    WIRE_MARK,          // Διαβάστηκε σήμανση τέλους εποχής (ο αριθμός της στο record.count)
+    WIRE_NEED_MORE,     // Το υπόλοιπο της εγγραφής δεν έχει φτάσει ακόμα
+    WIRE_ERROR          // Μη έγκυρα δεδομένα
+};
+
+// Μια αποκωδικοποιημένη εγγραφή. Η λέξη δείχνει μέσα στον buffer του reader
+// και δεν είναι τερματισμένη με '\0'.
+struct WireRecord {
+    const char* word;
+    size_t length;
+    uint64_t hash;      // Έγκυρο μόνο αν η ροή έχει WIRE_HASHES
+    uint64_t count;
+    uint64_t error;     // Μέγιστη υπερεκτίμηση του count (0 αν η ροή δεν έχει WIRE_ERRORS)
+};
+
+// Κωδικοποίηση εγγραφών σε WriteBuffer
+class WireWriter {
+private:
+    WriteBuffer& out;
+    unsigned flags;
+
+public:
+    WireWriter(WriteBuffer& out, unsigned flags) : out(out), flags(flags) {}
+
+    // Εγγραφή της κεφαλίδας της ροής
+    bool begin();
+
+    // Εγγραφή μιας λέξης με το πλήθος εμφανίσεών της (και το σφάλμα του, αν η ροή έχει WIRE_ERRORS)
+    bool word(const char* word, size_t length, uint64_t hash, uint64_t count, uint64_t error = 0);
+
+    // Σήμανση ότι τα δεδομένα της εποχής epoch έχουν σταλεί όλα
+    bool mark(uint64_t epoch);
+};
+
+// Αποκωδικοποίηση ροής που φτάνει σε τμήματα αυθαίρετου μεγέθους.
+// Μια εγγραφή που κόβεται στο τέλος των διαθέσιμων δεδομένων κρατείται μέχρι να συμπληρωθεί.
+class WireReader {
+private:
+    char* buffer;
+    size_t start;           // Πρώτο αδιάβαστο byte
+    size_t end;             // Τέλος των δεδομένων
+    size_t capacity;
+    bool headerSeen;
+    unsigned flags;
+
+    WireReader(const WireReader&);              // Δεν επιτρέπεται αντιγραφή
+    WireReader& operator=(const WireReader&);
+
+public:
+    WireReader();
+    ~WireReader();
+
+    // Χώρος για τουλάχιστον minSpace νέα bytes στο τέλος του buffer.
+    // Οι εγγραφές που επιστράφηκαν προηγουμένως παύουν να είναι έγκυρες.
+    char* prepare(size_t minSpace, size_t& available);
+
+    // Δήλωση ότι γράφτηκαν count bytes στο χώρο της prepare()
+    void commit(size_t count) { end += count; }
+
+    // Ανάγνωση από fd απευθείας στον buffer (επιστρέφει ό,τι και η read())
+    ssize_t readFrom(int fd);
+
+    // Επόμενη ολοκληρωμένη εγγραφή
+    WireStatus next(WireRecord& record);
+
+    // true αν δεν έχει μείνει μισή εγγραφή στον buffer
+    bool empty() const { return start == end; }
+
+    // true αν οι εγγραφές της ροής περιέχουν την τιμή κατακερματισμού
+    bool hasHashes() const { return (flags & WIRE_HASHES) != 0; }
+};
+
+#endif // WIRE_HPP
@@ -0,0 +1,115 @@
+// wordmap.cpp
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "wordmap.hpp"
+
+uint64_t wordHash(const char* word, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;    // FNV offset basis
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<unsigned char>(word[i]);
+        hash *= 1099511628211ULL;               // FNV prime
+    }
+    return hash;
+}
+
+static const size_t INITIAL_SLOTS = 1024;
+static const size_t INITIAL_ARENA = 16 * 1024;
+
+WordMap::WordMap() : slots(nullptr), slotCount(INITIAL_SLOTS), arena(nullptr), arenaSize(0), arenaCapacity(INITIAL_ARENA) {
+    slots = new uint32_t[slotCount]();
+    arena = new char[arenaCapacity];
+}
+
+WordMap::~WordMap() {
+    delete[] slots;
+    delete[] arena;
+}
+
+void WordMap::grow() {
+    size_t newCount = slotCount * 2;
+    uint32_t* newSlots = new uint32_t[newCount]();
+    size_t mask = newCount - 1;
+
+    // Επανατοποθέτηση με βάση τις αποθηκευμένες τιμές κατακερματισμού
+    for (size_t i = 0; i < entries.get_size(); i++) {
+        size_t pos = entries[i].hash & mask;
+        while (newSlots[pos] != 0) pos = (pos + 1) & mask;
+        newSlots[pos] = static_cast<uint32_t>(i + 1);
+    }
+
+    delete[] slots;
+    slots = newSlots;
+    slotCount = newCount;
+}
+
+void WordMap::clear() {
+    std::memset(slots, 0, slotCount * sizeof(uint32_t));
+    entries.clear();
+    arenaSize = 0;
+}
+
+void WordMap::reset() {
+    if (slotCount > INITIAL_SLOTS) {
+        delete[] slots;
+        slotCount = INITIAL_SLOTS;
+        slots = new uint32_t[slotCount];
+    }
+    if (arenaCapacity > INITIAL_ARENA) {
+        delete[] arena;
+        arenaCapacity = INITIAL_ARENA;
+        arena = new char[arenaCapacity];
+    }
+    clear();
+    entries = Vector<Entry>();      // Αποδέσμευση και του πίνακα των εγγραφών
+}
+
+uint64_t WordMap::storeWord(const char* word, size_t length) {
+    if (arenaSize + length + 1 > arenaCapacity) {
+        size_t newCapacity = arenaCapacity * 2;
+        while (arenaSize + length + 1 > newCapacity) newCapacity *= 2;
+        char* newArena = new char[newCapacity];
+        std::memcpy(newArena, arena, arenaSize);
+        delete[] arena;
+        arena = newArena;
+        arenaCapacity = newCapacity;
+    }
+
+    uint64_t offset = arenaSize;
+    std::memcpy(arena + arenaSize, word, length);
+    arena[arenaSize + length] = '\0';
+    arenaSize += length + 1;
+    return offset;
+}
+
+void WordMap::addHashed(const char* word, size_t length, uint64_t hash, long long delta) {
+    size_t mask = slotCount - 1;
+    size_t pos = hash & mask;
+
+    // Linear probing μέχρι να βρεθεί η λέξη ή κενή θέση
+    while (slots[pos] != 0) {
+        Entry& e = entries[slots[pos] - 1];
+        if (e.hash == hash && e.length == length && std::memcmp(arena + e.offset, word, length) == 0) {
+            e.count += delta;
+            return;
+        }
+        pos = (pos + 1) & mask;
+    }
+
+    // Νέα λέξη. Οι θέσεις κρατούν δείκτες 32 bit, οπότε μετά από UINT32_MAX εγγραφές (ή για λέξη
+    // με μήκος που δεν χωρά στο Entry) ο πίνακας θα αλλοίωνε σιωπηλά λέξεις.
+    if (entries.get_size() >= UINT32_MAX || length >= UINT32_MAX) {
+        std::fprintf(stderr, "WordMap: too many words (%zu entries, %zu bytes of words)\n", entries.get_size(), arenaSize);
+        std::exit(2);
+    }
+    Entry e;
+    e.hash = hash;
+    e.offset = storeWord(word, length);
+    e.length = static_cast<uint32_t>(length);
+    e.count = delta;
+    entries.push_back(e);
+    slots[pos] = static_cast<uint32_t>(entries.get_size());
+
+    // Διατήρηση συντελεστή φόρτωσης κάτω από 1/2
+    if (entries.get_size() * 2 > slotCount) grow();
+}
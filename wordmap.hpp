@@ -0,0 +1,68 @@
+#ifndef WORDMAP_HPP
+#define WORDMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "vector.hpp"
+
+// Συνάρτηση κατακερματισμού FNV-1a (64 bit) για μια λέξη συγκεκριμένου μήκους
+uint64_t wordHash(const char* word, size_t length);
+
+// Πίνακας κατακερματισμού ανοιχτής διευθυνσιοδότησης (linear probing) για καταμέτρηση λέξεων.
+// Οι λέξεις αποθηκεύονται συνεχόμενα σε ένα arena (τερματισμένες με '\0'),
+// ενώ οι εγγραφές (Entry) κρατούν μόνο τη θέση τους μέσα σε αυτό.
+class WordMap {
+public:
+    struct Entry {
+        uint64_t hash;      // Αποθηκευμένη τιμή κατακερματισμού (για γρήγορη σύγκριση και rehash)
+        uint64_t offset;    // Θέση της λέξης στο arena (το arena μπορεί να ξεπεράσει τα 4 GiB)
+        uint32_t length;    // Μήκος της λέξης
+        long long count;    // Πλήθος εμφανίσεων
+    };
+
+private:
+    Vector<Entry> entries;  // Πυκνός πίνακας εγγραφών με σειρά εισαγωγής
+    uint32_t* slots;        // Πίνακας κατακερματισμού: δείκτης εγγραφής + 1 (0 = κενή θέση, έως UINT32_MAX εγγραφές)
+    size_t slotCount;       // Πλήθος θέσεων (πάντα δύναμη του 2)
+    char* arena;            // Συνεχόμενη μνήμη για τις λέξεις
+    size_t arenaSize;       // Χρησιμοποιημένα bytes του arena
+    size_t arenaCapacity;   // Χωρητικότητα του arena
+
+    // Διπλασιασμός του πίνακα κατακερματισμού και επανατοποθέτηση των εγγραφών
+    void grow();
+
+    // Αποθήκευση μιας λέξης στο arena και επιστροφή της θέσης της
+    uint64_t storeWord(const char* word, size_t length);
+
+    WordMap(const WordMap&);              // Δεν επιτρέπεται αντιγραφή
+    WordMap& operator=(const WordMap&);
+
+public:
+    WordMap();
+    ~WordMap();
+
+    // Προσθέτει delta στο count της λέξης (η λέξη εισάγεται αν δεν υπάρχει)
+    void add(const char* word, size_t length, long long delta = 1) { addHashed(word, length, wordHash(word, length), delta); }
+
+    // Όπως η add, με ήδη υπολογισμένη την τιμή wordHash της λέξης.
+    // Οι SpillingCounts και SpaceSaving έχουν τις ίδιες add/addHashed, ώστε ο builder να τροφοδοτεί
+    // οποιονδήποτε από τους τρεις (βλ. buildercore.hpp).
+    void addHashed(const char* word, size_t length, uint64_t hash, long long delta);
+
+    // Αφαίρεση όλων των λέξεων. Η μνήμη κρατείται για επαναχρησιμοποίηση.
+    void clear();
+
+    // Αφαίρεση όλων των λέξεων και επιστροφή των θέσεων, των εγγραφών και του arena στην αρχική
+    // χωρητικότητα, ώστε ένας πίνακας με όριο μνήμης να μην κρατά το μέγεθος της κορυφής του
+    void reset();
+
+    // Εκτίμηση της μνήμης που καταλαμβάνουν οι λέξεις του πίνακα σε bytes
+    // (εγγραφές, θέσεις με συντελεστή φόρτωσης 1/2 και arena)
+    size_t memoryUsage() const { return entries.get_size() * (sizeof(Entry) + 2 * sizeof(uint32_t)) + arenaSize; }
+
+    size_t get_size() const { return entries.get_size(); }
+    const Entry& entry(size_t index) const { return entries[index]; }
+    const char* word(const Entry& e) const { return arena + e.offset; }
+};
+
+#endif // WORDMAP_HPP
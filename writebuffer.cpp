@@ -0,0 +1,73 @@
+// writebuffer.cpp
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include "writebuffer.hpp"
+#include "ring.hpp"
+#include "stats.hpp"
+#include "trace.hpp"
+
+WriteBuffer::WriteBuffer(int fd, size_t capacity) : fd(fd), ring(nullptr), data(new char[capacity]), length(0), capacity(capacity), writeCalls(0), blockedTime(0) {}
+
+WriteBuffer::WriteBuffer(SpscRing* ring, size_t capacity) : fd(-1), ring(ring), data(new char[capacity]), length(0), capacity(capacity), writeCalls(0), blockedTime(0) {}
+
+WriteBuffer::~WriteBuffer() {
+    delete[] data;
+}
+
+bool WriteBuffer::writeAll(const char* bytes, size_t count) {
+    // Μία μέτρηση χρόνου ανά πλαίσιο, όχι ανά λέξη
+    TraceSpan span("write");
+    double start = clockSeconds(CLOCK_MONOTONIC);
+    if (ring != nullptr) {
+        writeCalls++;
+        bool ok = ring->write(bytes, count);
+        blockedTime += clockSeconds(CLOCK_MONOTONIC) - start;
+        return ok;
+    }
+    while (count > 0) {
+        ssize_t bytes_written = write(fd, bytes, count);
+        writeCalls++;
+        if (bytes_written == -1) {
+            if (errno == EINTR) continue;
+            std::perror("write");
+            return false;
+        }
+        bytes += bytes_written;
+        count -= bytes_written;
+    }
+    blockedTime += clockSeconds(CLOCK_MONOTONIC) - start;
+    return true;
+}
+
+bool WriteBuffer::append(const char* bytes, size_t count) {
+    if (length + count > capacity) {
+        if (!flush()) return false;
+        // Δεδομένα μεγαλύτερα από ένα πλαίσιο γράφονται απευθείας
+        if (count > capacity) return writeAll(bytes, count);
+    }
+    std::memcpy(data + length, bytes, count);
+    length += count;
+    return true;
+}
+
+bool WriteBuffer::flush() {
+    if (length == 0) return true;
+    bool ok = writeAll(data, length);
+    length = 0;
+    return ok;
+}
+
+bool WriteBuffer::close() {
+    bool ok = flush();
+    if (fd != -1) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (ring != nullptr) {
+        ring->close();
+        ring = nullptr;
+    }
+    return ok;
+}
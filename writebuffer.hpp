@@ -0,0 +1,46 @@
+#ifndef WRITEBUFFER_HPP
+#define WRITEBUFFER_HPP
+
+#include <cstddef>
+
+class SpscRing;
+
+// Buffer εξόδου προς έναν file descriptor (π.χ. named pipe).
+// Τα δεδομένα συγκεντρώνονται και γράφονται με μία κλήση write() ανά πλαίσιο
+// μεγέθους capacity, αντί για μία κλήση ανά λέξη. Εναλλακτικά τα πλαίσια γράφονται
+// σε δακτύλιο SpscRing (λειτουργία --threads), χωρίς κλήσεις συστήματος.
+class WriteBuffer {
+private:
+    int fd;             // Προορισμός των δεδομένων
+    SpscRing* ring;     // Προορισμός αντί του fd (nullptr για εγγραφή σε fd)
+    char* data;         // Συγκεντρωμένα δεδομένα που δεν έχουν γραφτεί ακόμα
+    size_t length;      // Πλήθος bytes στο buffer
+    size_t capacity;    // Μέγεθος πλαισίου (batch size)
+    size_t writeCalls;  // Πλήθος κλήσεων write()
+    double blockedTime; // Χρόνος μέσα στις εγγραφές σε δευτερόλεπτα (αναμονή όταν ο παραλήπτης δεν προλαβαίνει)
+
+    // Εγγραφή όλων των bytes, με επανάληψη σε μερικές εγγραφές
+    bool writeAll(const char* bytes, size_t count);
+
+    WriteBuffer(const WriteBuffer&);              // Δεν επιτρέπεται αντιγραφή
+    WriteBuffer& operator=(const WriteBuffer&);
+
+public:
+    WriteBuffer(int fd, size_t capacity);
+    WriteBuffer(SpscRing* ring, size_t capacity);
+    ~WriteBuffer();
+
+    // Προσθήκη bytes, με αποστολή του πλαισίου όταν γεμίσει (false σε σφάλμα εγγραφής)
+    bool append(const char* bytes, size_t count);
+
+    // Αποστολή όσων δεδομένων έχουν συγκεντρωθεί
+    bool flush();
+
+    // Αποστολή των υπολοίπων δεδομένων και κλείσιμο του fd (ή τέλος της ροής του δακτυλίου)
+    bool close();
+
+    size_t get_writeCalls() const { return writeCalls; }
+    double get_blockedTime() const { return blockedTime; }
+};
+
+#endif // WRITEBUFFER_HPP